@@ -1263,6 +1263,23 @@ public:
      */
     Result order(bool strokeFirst) noexcept;
 
+    /**
+     * @brief Draws the shape multiple times with the given transformations and opacities.
+     *
+     * Each instance is rendered as a copy of this shape, with its matrix applied to the path before the shape's own transformation.
+     * This is a lightweight alternative to creating a separate shape for each copy, as rendering engines may share the geometry data among the instances.
+     *
+     * @param[in] transforms The array of the instance transformation matrices.
+     * @param[in] opacities The array of the instance opacities, multiplied to the shape opacity. If @c nullptr, all instances are opaque.
+     * @param[in] cnt The number of the instances. If @c 0, the shape is drawn once as usual.
+     *
+     * @retval Result::InvalidArguments In case @p transforms is @c nullptr with a non-zero @p cnt.
+     *
+     * @note The instances are drawn in the given order. They are ignored if the shape is used as a clipper.
+     * @note Experimental API
+     */
+    Result instances(const Matrix* transforms, const uint8_t* opacities, uint32_t cnt) noexcept;
+
     /**
      * @brief Retrieves the current path data of the shape.
      *
@@ -1589,6 +1606,45 @@ public:
      */
     Result remove(Paint* paint = nullptr) noexcept;
 
+    /**
+     * @brief Finds the topmost paints intersecting each of the given regions in a single pass.
+     *
+     * This is the batched version of Paint::intersects() over the scene tree. The traversal, the bounding box tests
+     * and the children spatial index are shared among all queries, which is useful for hover detection of many items.
+     * For each region, the frontmost leaf paint (Shape, Picture or Text) whose filled area intersects it is returned.
+     *
+     * The scene must be updated in a Canvas beforehand—typically after the Canvas has been drawn and synchronized.
+     *
+     * @param[in] regions The test regions given as @p cnt sequential sets of {x, y, w, h} values. Each width and height must be greater than 0.
+     * @param[in] cnt The number of the test regions.
+     * @param[out] hits An array of @p cnt elements that receives the topmost paint for each region, or @c nullptr if nothing was hit.
+     *
+     * @retval Result::InvalidArguments In case @p regions or @p hits is @c nullptr.
+     *
+     * @note This test does not take into account the results of blending or masking.
+     * @note This test does take into account the the hidden paints as well. @see Paint::visible()
+     * @see Paint::intersects()
+     * @note Experimental API
+     */
+    Result pick(const int32_t* regions, uint32_t cnt, Paint** hits) noexcept;
+
+    /**
+     * @brief Reports every paint intersecting the given regions in a single pass.
+     *
+     * Similar to Scene::pick(const int32_t*, uint32_t, Paint**), but @p func is called for every intersecting leaf paint
+     * of every region. The hits of a region are reported from the frontmost to the backmost paint.
+     *
+     * @param[in] regions The test regions given as @p cnt sequential sets of {x, y, w, h} values. Each width and height must be greater than 0.
+     * @param[in] cnt The number of the test regions.
+     * @param[in] func The callback function receiving the index of the region and the intersecting paint. Return @c false to stop the search.
+     * @param[in] data Data passed to the @p func as its argument.
+     *
+     * @retval Result::InvalidArguments In case @p regions or @p func is @c nullptr.
+     *
+     * @note Experimental API
+     */
+    Result pick(const int32_t* regions, uint32_t cnt, std::function<bool(uint32_t idx, Paint* paint, void* data)> func, void* data) noexcept;
+
     /**
      * @brief Apply a post-processing effect to the scene.
      *
@@ -2095,6 +2151,53 @@ public:
      */
     Result segment(float* begin, float* end = nullptr) noexcept;
 
+    /**
+     * @brief Renders a range of the animation frames into the given buffers.
+     *
+     * The frame @p begin + @c i * @p step is drawn into @p buffers[@c i] for each @c i from @c 0 to @p cnt - 1.
+     * The frames are rendered concurrently by the independent instances of this animation which share its model data,
+     * therefore neither the current frame nor the picture of this animation is affected.
+     * The size and the transformation of the picture are applied to every frame.
+     *
+     * @param[in] buffers The array of the @p cnt frame buffers, each of them has at least @p stride x @p h pixels.
+     * @param[in] cnt The number of the frames to render.
+     * @param[in] stride The stride of the buffers, the number of pixels per row.
+     * @param[in] w The width of the frames.
+     * @param[in] h The height of the frames.
+     * @param[in] cs The color space of the buffers.
+     * @param[in] begin The frame number of the first frame, in the current segment.
+     * @param[in] step The difference of the frame numbers between the adjacent buffers.
+     *
+     * @retval Result::InsufficientCondition In case the animation is not loaded.
+     * @retval Result::InvalidArguments In case any of the buffers is @c nullptr or the frame size is invalid.
+     * @retval Result::NonSupport When it's not animatable, the software raster engine is not available,
+     *         or the animation data could not be shared, such as Lottie with expressions or overridden slots.
+     *
+     * @note The buffers could point the cells of a single sprite sheet, with the stride of the sheet.
+     * @note Experimental API
+     */
+    Result render(uint32_t** buffers, uint32_t cnt, uint32_t stride, uint32_t w, uint32_t h, ColorSpace cs, float begin, float step = 1.0f) noexcept;
+
+    /**
+     * @brief Keeps the rendered frames of the animation to draw them again without updating and rasterizing the scene.
+     *
+     * Once it's enabled, the picture draws the frames as images in the resolution of the target. The frame is rendered
+     * by an independent instance of this animation on its first appearance and stored. When the total size of the stored
+     * frames exceeds the @p budget, the oldest ones are dropped. The looping animations take the stored frames from the second loop.
+     * The stored frames are dropped when the target resolution or the color space changes, or when the contents of the animation are changed.
+     *
+     * @param[in] budget The memory limit of the stored frames in bytes. @c 0 disables the cache and releases the frames.
+     * @param[in] compress If @c true, the frames are stored by their areas differ from the first stored frame.
+     *
+     * @retval Result::InsufficientCondition In case the animation is not loaded.
+     * @retval Result::NonSupport When it's not animatable, the software raster engine is not available,
+     *         or the animation data could not be shared, such as Lottie with expressions or overridden slots.
+     *
+     * @note The frames are stored by their frame numbers only, the animations with the non-deterministic contents must not use it.
+     * @note Experimental API
+     */
+    Result cache(uint32_t budget, bool compress = false) noexcept;
+
     /**
      * @brief Creates a new Animation object.
      *
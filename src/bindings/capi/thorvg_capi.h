@@ -1578,6 +1578,24 @@ TVG_API Tvg_Result tvg_shape_get_fill_rule(const Tvg_Paint* paint, Tvg_Fill_Rule
 TVG_API Tvg_Result tvg_shape_set_paint_order(Tvg_Paint* paint, bool strokeFirst);
 
 
+/*!
+* @brief Draws the shape multiple times with the given transformations and opacities.
+*
+* Each instance is rendered as a copy of the shape, with its matrix applied to the path before the shape's own transformation.
+*
+* @param[in] paint A Tvg_Paint pointer to the shape object.
+* @param[in] transforms The array of the instance transformation matrices.
+* @param[in] opacities The array of the instance opacities. If @c NULL, all instances are opaque.
+* @param[in] cnt The number of the instances. If @c 0, the shape is drawn once as usual.
+*
+* @return Tvg_Result enumeration.
+* @retval TVG_RESULT_INVALID_ARGUMENT An invalid Tvg_Paint pointer or @p transforms is @c NULL with a non-zero @p cnt.
+*
+* @note Experimental API
+*/
+TVG_API Tvg_Result tvg_shape_set_instances(Tvg_Paint* paint, const Tvg_Matrix* transforms, const uint8_t* opacities, uint32_t cnt);
+
+
 /*!
 * @brief Sets the gradient fill for all of the figures from the path.
 *
@@ -2060,6 +2078,23 @@ TVG_API Tvg_Result tvg_scene_push_at(Tvg_Paint* scene, Tvg_Paint* target, Tvg_Pa
 TVG_API Tvg_Result tvg_scene_remove(Tvg_Paint* scene, Tvg_Paint* paint);
 
 
+/**
+ * @brief Finds the topmost paints intersecting each of the given regions in a single pass.
+ *
+ * For each region, the frontmost leaf paint (shape, picture or text) in the scene whose filled area intersects it is returned.
+ * The scene must be updated in a canvas beforehand—typically after the canvas has been drawn and synchronized.
+ *
+ * @param[in] scene A Tvg_Paint pointer to the scene object.
+ * @param[in] regions The test regions given as @p cnt sequential sets of {x, y, w, h} values.
+ * @param[in] cnt The number of the test regions.
+ * @param[out] hits An array of @p cnt elements that receives the topmost paint for each region, or @c NULL if nothing was hit.
+ *
+ * @see tvg_paint_intersects()
+ * @note Experimental API
+ */
+TVG_API Tvg_Result tvg_scene_pick(Tvg_Paint* scene, const int32_t* regions, uint32_t cnt, Tvg_Paint** hits);
+
+
 /**
  * @brief Resets all previously applied scene effects.
  *
@@ -2578,6 +2613,52 @@ TVG_API Tvg_Result tvg_animation_set_segment(Tvg_Animation* animation, float beg
 TVG_API Tvg_Result tvg_animation_get_segment(Tvg_Animation* animation, float* begin, float* end);
 
 
+/*!
+* @brief Renders a range of the animation frames into the given buffers.
+*
+* The frame @p begin + @c i * @p step is drawn into @p buffers[@c i] for each @c i from @c 0 to @p cnt - 1.
+* The frames are rendered concurrently, the current frame of the animation is not affected.
+*
+* @param[in] animation The Tvg_Animation pointer to the animation object.
+* @param[in] buffers The array of the @p cnt frame buffers, each of them has at least @p stride x @p h pixels.
+* @param[in] cnt The number of the frames to render.
+* @param[in] stride The stride of the buffers, the number of pixels per row.
+* @param[in] w The width of the frames.
+* @param[in] h The height of the frames.
+* @param[in] cs The color space of the buffers.
+* @param[in] begin The frame number of the first frame, in the current segment.
+* @param[in] step The difference of the frame numbers between the adjacent buffers.
+*
+* @return Tvg_Result enumeration.
+* @retval TVG_RESULT_INSUFFICIENT_CONDITION In case the animation is not loaded.
+* @retval TVG_RESULT_INVALID_ARGUMENT An invalid Tvg_Animation pointer, buffers or frame size.
+* @retval TVG_RESULT_NOT_SUPPORTED When it's not animatable or the animation data could not be shared.
+*
+* @note Experimental API
+*/
+TVG_API Tvg_Result tvg_animation_render(Tvg_Animation* animation, uint32_t** buffers, uint32_t cnt, uint32_t stride, uint32_t w, uint32_t h, Tvg_Colorspace cs, float begin, float step);
+
+
+/*!
+* @brief Keeps the rendered frames of the animation to draw them again without updating and rasterizing the scene.
+*
+* The frame is rendered by an independent instance of the animation on its first appearance and stored. When the total size
+* of the stored frames exceeds the @p budget, the oldest ones are dropped.
+*
+* @param[in] animation The Tvg_Animation pointer to the animation object.
+* @param[in] budget The memory limit of the stored frames in bytes. @c 0 disables the cache and releases the frames.
+* @param[in] compress If @c true, the frames are stored by their areas differ from the first stored frame.
+*
+* @return Tvg_Result enumeration.
+* @retval TVG_RESULT_INSUFFICIENT_CONDITION In case the animation is not loaded.
+* @retval TVG_RESULT_INVALID_ARGUMENT An invalid Tvg_Animation pointer.
+* @retval TVG_RESULT_NOT_SUPPORTED When it's not animatable or the animation data could not be shared.
+*
+* @note Experimental API
+*/
+TVG_API Tvg_Result tvg_animation_cache(Tvg_Animation* animation, uint32_t budget, bool compress);
+
+
 /*!
 * @brief Deletes the given Tvg_Animation object.
 *
@@ -2699,6 +2780,8 @@ TVG_API Tvg_Animation* tvg_lottie_animation_new(void);
 * @retval TVG_RESULT_INVALID_ARGUMENT When the given @p slot is invalid
 * @retval TVG_RESULT_NOT_SUPPORTED The Lottie Animation is not supported.
 *
+* @note The slots given in one data are applied as a batch, only the overridden contents are built again on the next update.
+*
 * @since 1.0
 */
 TVG_API Tvg_Result tvg_lottie_animation_override(Tvg_Animation* animation, const char* slot);
@@ -2786,6 +2869,37 @@ TVG_API Tvg_Result tvg_lottie_animation_tween(Tvg_Animation* animation, float fr
 */
 TVG_API Tvg_Result tvg_lottie_animation_assign(Tvg_Animation* animation, const char* layer, uint32_t ix, const char* var, float val);
 
+
+/*!
+* \brief Sets the frame time budget, the rendering costs of the animation are reduced while it's exceeded.
+*
+* \param[in] animation The Tvg_Animation pointer to the Lottie animation object.
+* \param[in] time The frame time budget in milliseconds. @c 0 disables it and restores the full quality.
+*
+* \return Tvg_Result enumeration.
+* \retval TVG_RESULT_INSUFFICIENT_CONDITION If the animation is not loaded.
+* \retval TVG_RESULT_INVALID_ARGUMENT An invalid Tvg_Animation pointer or a negative @p time.
+*
+* \see tvg_lottie_animation_get_quality()
+* \note Experimental API
+*/
+TVG_API Tvg_Result tvg_lottie_animation_set_budget(Tvg_Animation* animation, float time);
+
+
+/*!
+* \brief Gets the current quality of the animation under the frame time budget.
+*
+* \param[in] animation The Tvg_Animation pointer to the Lottie animation object.
+* \param[out] quality The quality in percent, @c 100 is the full quality and @c 0 is the most reduced one.
+*
+* \return Tvg_Result enumeration.
+* \retval TVG_RESULT_INVALID_ARGUMENT An invalid Tvg_Animation pointer or @p quality.
+*
+* \see tvg_lottie_animation_set_budget()
+* \note Experimental API
+*/
+TVG_API Tvg_Result tvg_lottie_animation_get_quality(Tvg_Animation* animation, uint8_t* quality);
+
 /** \} */   // end addtogroup ThorVGCapi_LottieAnimation
 
 
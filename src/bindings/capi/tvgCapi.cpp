@@ -578,6 +578,13 @@ TVG_API Tvg_Result tvg_shape_set_paint_order(Tvg_Paint* paint, bool strokeFirst)
 }
 
 
+TVG_API Tvg_Result tvg_shape_set_instances(Tvg_Paint* paint, const Tvg_Matrix* transforms, const uint8_t* opacities, uint32_t cnt)
+{
+    if (paint) return (Tvg_Result) reinterpret_cast<Shape*>(paint)->instances(reinterpret_cast<const Matrix*>(transforms), opacities, cnt);
+    return TVG_RESULT_INVALID_ARGUMENT;
+}
+
+
 TVG_API Tvg_Result tvg_shape_set_gradient(Tvg_Paint* paint, Tvg_Gradient* gradient)
 {
     if (paint) return (Tvg_Result) reinterpret_cast<Shape*>(paint)->fill((Fill*)gradient);
@@ -800,6 +807,13 @@ TVG_API Tvg_Result tvg_scene_remove(Tvg_Paint* scene, Tvg_Paint* paint)
 }
 
 
+TVG_API Tvg_Result tvg_scene_pick(Tvg_Paint* scene, const int32_t* regions, uint32_t cnt, Tvg_Paint** hits)
+{
+    if (scene) return (Tvg_Result) reinterpret_cast<Scene*>(scene)->pick(regions, cnt, (Paint**)hits);
+    return TVG_RESULT_INVALID_ARGUMENT;
+}
+
+
 TVG_API Tvg_Result tvg_scene_reset_effects(Tvg_Paint* scene)
 {
     if (scene) return (Tvg_Result) reinterpret_cast<Scene*>(scene)->push(SceneEffect::ClearAll);
@@ -1000,6 +1014,20 @@ TVG_API Tvg_Result tvg_animation_get_segment(Tvg_Animation* animation, float* st
 }
 
 
+TVG_API Tvg_Result tvg_animation_render(Tvg_Animation* animation, uint32_t** buffers, uint32_t cnt, uint32_t stride, uint32_t w, uint32_t h, Tvg_Colorspace cs, float begin, float step)
+{
+    if (animation) return (Tvg_Result) reinterpret_cast<Animation*>(animation)->render(buffers, cnt, stride, w, h, static_cast<ColorSpace>(cs), begin, step);
+    return TVG_RESULT_INVALID_ARGUMENT;
+}
+
+
+TVG_API Tvg_Result tvg_animation_cache(Tvg_Animation* animation, uint32_t budget, bool compress)
+{
+    if (animation) return (Tvg_Result) reinterpret_cast<Animation*>(animation)->cache(budget, compress);
+    return TVG_RESULT_INVALID_ARGUMENT;
+}
+
+
 TVG_API Tvg_Result tvg_animation_del(Tvg_Animation* animation)
 {
     if (animation) {
@@ -1123,6 +1151,29 @@ TVG_API Tvg_Result tvg_lottie_animation_assign(Tvg_Animation* animation, const c
     return TVG_RESULT_NOT_SUPPORTED;
 }
 
+
+TVG_API Tvg_Result tvg_lottie_animation_set_budget(Tvg_Animation* animation, float time)
+{
+#ifdef THORVG_LOTTIE_LOADER_SUPPORT
+    if (animation) return (Tvg_Result) reinterpret_cast<LottieAnimation*>(animation)->budget(time);
+    return TVG_RESULT_INVALID_ARGUMENT;
+#endif
+    return TVG_RESULT_NOT_SUPPORTED;
+}
+
+
+TVG_API Tvg_Result tvg_lottie_animation_get_quality(Tvg_Animation* animation, uint8_t* quality)
+{
+#ifdef THORVG_LOTTIE_LOADER_SUPPORT
+    if (animation && quality) {
+        *quality = reinterpret_cast<LottieAnimation*>(animation)->quality();
+        return TVG_RESULT_SUCCESS;
+    }
+    return TVG_RESULT_INVALID_ARGUMENT;
+#endif
+    return TVG_RESULT_NOT_SUPPORTED;
+}
+
 #ifdef __cplusplus
 }
 #endif
@@ -85,6 +85,7 @@ struct Inlist
         auto t = tail;
         tail = t->prev;
         if (!tail) head = nullptr;
+        else tail->next = nullptr;
         return t;
     }
 
@@ -94,6 +95,7 @@ struct Inlist
         auto t = head;
         head = t->next;
         if (!head) tail = nullptr;
+        else head->prev = nullptr;
         return t;
     }
 
@@ -18,12 +18,15 @@
 #include <math.h>
 
 #include "ecma-eval.h"
+#include "ecma-exceptions.h"
 #include "ecma-function-object.h"
 #include "ecma-gc.h"
 #include "ecma-init-finalize.h"
 #include "ecma-objects-general.h"
 #include "ecma-objects.h"
 #include "jcontext.h"
+#include "js-parser.h"
+#include "vm.h"
 
 /** \addtogroup jerry Jerry engine interface
  * @{
@@ -164,6 +167,102 @@ jerry_eval (const jerry_char_t *source_p, /**< source code */
   return jerry_return (ecma_op_eval_chars_buffer ((void *) &source_char, flags));
 } /* jerry_eval */
 
+/**
+ * Free callback of the parsed script, releases its byte-code
+ */
+static void
+jerry_script_free (void *native_p, /**< byte-code */
+                   struct jerry_object_native_info_t *info_p) /**< native type info */
+{
+  JERRY_UNUSED (info_p);
+  ecma_bytecode_deref ((ecma_compiled_code_t *) native_p);
+} /* jerry_script_free */
+
+/**
+ * Native type info of the parsed script
+ */
+static const jerry_object_native_info_t jerry_script_info = { jerry_script_free, 0, 0 };
+
+/**
+ * Parse the source code once to run it multiple times by jerry_run with the same semantics as jerry_eval
+ *
+ * Note:
+ *      returned value must be freed with jerry_value_free, when it is no longer needed.
+ *
+ * @return the script, may be error value.
+ */
+jerry_value_t
+jerry_parse (const jerry_char_t *source_p, /**< source code */
+             size_t source_size, /**< length of source code */
+             uint32_t flags) /**< jerry_parse_opts_t flags */
+{
+#if JERRY_PARSER
+  parser_source_char_t source_char;
+  source_char.source_p = source_p;
+  source_char.source_size = source_size;
+
+  ECMA_CLEAR_LOCAL_PARSE_OPTS ();
+
+  ecma_compiled_code_t *bytecode_p =
+    parser_parse_script ((void *) &source_char, (flags & (uint32_t) ~ECMA_PARSE_STRICT_MODE) | ECMA_PARSE_EVAL, NULL);
+
+  if (JERRY_UNLIKELY (bytecode_p == NULL))
+  {
+    return ecma_create_exception_from_context ();
+  }
+
+  jerry_value_t script = jerry_object ();
+  jerry_object_set_native_ptr (script, &jerry_script_info, bytecode_p);
+  return script;
+#else /* !JERRY_PARSER */
+  JERRY_UNUSED (source_p);
+  JERRY_UNUSED (source_size);
+  JERRY_UNUSED (flags);
+
+  return ecma_raise_syntax_error (ECMA_ERR_PARSER_NOT_SUPPORTED);
+#endif /* JERRY_PARSER */
+} /* jerry_parse */
+
+/**
+ * Run the script parsed by jerry_parse
+ *
+ * Note:
+ *      returned value must be freed with jerry_value_free, when it is no longer needed.
+ *
+ * @return result of the script, may be error value.
+ */
+jerry_value_t
+jerry_run (const jerry_value_t script) /**< script parsed by jerry_parse */
+{
+  ecma_compiled_code_t *bytecode_p = (ecma_compiled_code_t *) jerry_object_get_native_ptr (script, &jerry_script_info);
+
+  if (bytecode_p == NULL)
+  {
+    return jerry_undefined ();
+  }
+
+  /* the byte-code is released after running */
+  ecma_bytecode_ref (bytecode_p);
+  return jerry_return (vm_run_eval (bytecode_p, ECMA_PARSE_EVAL));
+} /* jerry_run */
+
+/**
+ * Call a function object
+ *
+ * Note:
+ *      returned value must be freed with jerry_value_free, when it is no longer needed.
+ *
+ * @return result of the function call, may be error value.
+ */
+jerry_value_t
+jerry_call (const jerry_value_t func_object, /**< function object to call */
+            const jerry_value_t this_value, /**< object for 'this' binding */
+            const jerry_value_t *args_p, /**< function's call arguments */
+            jerry_size_t args_count) /**< number of the arguments */
+{
+  return jerry_return (ecma_op_function_validated_call (func_object, this_value, args_p, args_count));
+} /* jerry_call */
+
 /**
  * Get global object
  *
@@ -310,6 +409,17 @@ jerry_value_as_uint32 (const jerry_value_t value) /**< input value */
   return ecma_number_to_uint32 (ecma_get_number_from_value (value));
 } /* jerry_value_as_uint32 */
 
+/**
+ * Copy the argument value, the copy must be freed with jerry_value_free as well
+ *
+ * @return copied value
+ */
+jerry_value_t
+jerry_value_copy (const jerry_value_t value) /**< value */
+{
+  return ecma_copy_value (value);
+} /* jerry_value_copy */
+
 /**
  * Release ownership of the argument value
  */
@@ -25,7 +25,9 @@ void jerry_cleanup (void);
 jerry_value_t jerry_current_realm (void);
 jerry_value_t jerry_set_realm (jerry_value_t realm);
 jerry_value_t jerry_eval (const jerry_char_t *source_p, size_t source_size, uint32_t flags);
+jerry_value_t jerry_parse (const jerry_char_t *source_p, size_t source_size, uint32_t flags);
 jerry_value_t jerry_run (const jerry_value_t script);
+jerry_value_t jerry_call (const jerry_value_t func_object, const jerry_value_t this_value, const jerry_value_t *args_p, jerry_size_t args_count);
 bool jerry_value_is_undefined (const jerry_value_t value);
 bool jerry_value_is_number (const jerry_value_t value);
 bool jerry_value_is_object (const jerry_value_t value);
@@ -59,6 +61,7 @@ jerry_value_t jerry_object_get_sz (const jerry_value_t object, const char *key_p
 jerry_value_t jerry_object_get_index (const jerry_value_t object, uint32_t index);
 void *jerry_object_get_native_ptr (const jerry_value_t object, const jerry_object_native_info_t *native_info_p);
 jerry_value_t jerry_function_external (jerry_external_handler_t handler);
+jerry_value_t jerry_value_copy (const jerry_value_t value);
 void jerry_value_free (jerry_value_t value);
 
 JERRY_C_API_END
@@ -29,6 +29,10 @@ public:
      *
      * @retval Result::InsufficientCondition In case the animation is not loaded.
      *
+     * @note The slots given in one data, e.g. @c {"color":{...},"opacity":{...}}, are applied as a batch.
+     *       The changes of the consecutive calls are also gathered until the next update,
+     *       which builds only the contents of the overridden properties again.
+     *
      * @since 1.0
      */
     Result override(const char* slot) noexcept;
@@ -110,6 +114,50 @@ public:
      */
     Result assign(const char* layer, uint32_t ix, const char* var, float val);
 
+    /**
+     * @brief Sets the frame time budget, the rendering costs of the animation are reduced while it's exceeded.
+     *
+     * The time is measured from updating the picture of the animation to the end of its drawing.
+     * When the frames exceed the budget, the quality is reduced step by step from the next frame:
+     * the blur and the shadow effects are drawn with the lowest quality, the layers are drawn without their blending methods,
+     * and then the hardly visible layers are skipped. The quality is restored step by step when the frames take less than half of the budget.
+     *
+     * @param[in] time The frame time budget in milliseconds. @c 0 disables it and restores the full quality.
+     *
+     * @retval Result::InsufficientCondition In case the animation is not loaded.
+     * @retval Result::InvalidArguments In case the @p time is negative.
+     *
+     * @note The drawing time is measured on the calling thread. It includes the rasterization of the software engine,
+     *       but not the deferred rendering of the hardware engines.
+     * @note The mattes and the masks are composited in the full resolution and the shapes are always anti-aliased,
+     *       these are not reduced under the budget.
+     * @see LottieAnimation::quality()
+     * @note Experimental API
+     */
+    Result budget(float time) noexcept;
+
+    /**
+     * @brief Gets the current quality of the animation under the frame time budget.
+     *
+     * @return The quality in percent, @c 100 is the full quality and @c 0 is the most reduced one.
+     *
+     * @see LottieAnimation::budget()
+     * @note Experimental API
+     */
+    uint8_t quality() noexcept;
+
+    /**
+     * @brief Gets the size of the model data shared with the other animations of the same file.
+     *
+     * The animations loaded from the same file borrow the keyframe data of the first loaded one, each of them owns only its objects.
+     * The animations with the expressions or the overridden slots don't share the model.
+     *
+     * @return The size of the borrowed keyframe data in bytes, @c 0 if the animation owns the whole model.
+     *
+     * @note Experimental API
+     */
+    uint32_t shared() noexcept;
+
     /**
      * @brief Creates a new LottieAnimation object.
      *
@@ -20,11 +20,88 @@
  * SOFTWARE.
  */
 
+#include <chrono>
 #include "tvgCommon.h"
 #include "thorvg_lottie.h"
 #include "tvgLottieLoader.h"
+#include "tvgLottieModel.h"
+#include "tvgLottieBuilder.h"
 #include "tvgAnimation.h"
 
+/************************************************************************/
+/* Internal Class Implementation                                        */
+/************************************************************************/
+
+//steps the rendering costs of the animation down and up to keep the frame time within the budget
+struct LottieGovernor : PictureMonitor
+{
+    static constexpr uint8_t MAX_LEVEL = LottieBuilder::Degrade::FaintLayers;
+    static constexpr uint8_t OVERRUNS = 2;      //the consecutive frames beyond the budget to reduce the quality
+    static constexpr uint8_t HEADROOMS = 30;    //the consecutive frames within the half of the budget to restore the quality
+
+    Picture* picture;
+    chrono::steady_clock::time_point start;
+    float budget;                               //in milliseconds
+    uint8_t level = 0;
+    uint8_t overruns = 0, headrooms = 0;
+    bool started = false;
+
+    LottieGovernor(Picture* picture, float budget) : picture(picture), budget(budget) {}
+
+    ~LottieGovernor()
+    {
+        level = 0;
+        apply();
+    }
+
+    void begin() override
+    {
+        //the canvas could update the picture again prior to the drawing
+        if (started) return;
+        start = chrono::steady_clock::now();
+        started = true;
+    }
+
+    void end() override
+    {
+        if (!started) return;
+        started = false;
+
+        auto elapsed = chrono::duration<float, milli>(chrono::steady_clock::now() - start).count();
+
+        if (elapsed > budget) {
+            headrooms = 0;
+            if (++overruns >= OVERRUNS && level < MAX_LEVEL) {
+                ++level;
+                overruns = 0;
+                apply();
+            }
+        } else if (elapsed < budget * 0.5f) {
+            overruns = 0;
+            if (++headrooms >= HEADROOMS && level > 0) {
+                --level;
+                headrooms = 0;
+                apply();
+            }
+        } else {
+            overruns = headrooms = 0;
+        }
+    }
+
+    //takes effect from the next frame
+    void apply()
+    {
+        auto loader = static_cast<LottieLoader*>(PICTURE(picture)->loader);
+        if (!loader) return;
+        loader->done();
+        loader->builder->reduce(level);
+    }
+};
+
+/************************************************************************/
+/* External Class Implementation                                        */
+/************************************************************************/
+
 
 LottieAnimation::LottieAnimation() = default;
 LottieAnimation::~LottieAnimation() = default;
@@ -35,8 +112,9 @@ Result LottieAnimation::override(const char* slot) noexcept
     auto loader = PICTURE(pImpl->picture)->loader;
     if (!loader) return Result::InsufficientCondition;
 
+    //the picture is not marked, the loader updates only the paints of the overridden contents
     if (static_cast<LottieLoader*>(loader)->override(slot)) {
-        PAINT(pImpl->picture)->mark(RenderUpdateFlag::All);
+        pImpl->invalidate(true);
         return Result::Success;
     }
     return Result::InvalidArguments;
@@ -63,7 +141,10 @@ Result LottieAnimation::tween(float from, float to, float progress) noexcept
 {
     auto loader = PICTURE(pImpl->picture)->loader;
     if (!loader) return Result::InsufficientCondition;
+    auto pending = PICTURE(pImpl->picture)->wait();
     if (!static_cast<LottieLoader*>(loader)->tween(from, to, progress)) return Result::InsufficientCondition;
+    if (pending) loader->sync();
+    pImpl->invalidate(false);
     PAINT(pImpl->picture)->mark(RenderUpdateFlag::All);
     return Result::Success;
 }
@@ -85,6 +166,14 @@ const char* LottieAnimation::marker(uint32_t idx) noexcept
 }
 
 
+uint32_t LottieAnimation::shared() noexcept
+{
+    auto loader = PICTURE(pImpl->picture)->loader;
+    if (!loader) return 0;
+    return static_cast<LottieLoader*>(loader)->borrowed();
+}
+
+
 Result LottieAnimation::assign(const char* layer, uint32_t ix, const char* var, float val)
 {
     if (!layer || !var) return Result::InvalidArguments;
@@ -92,6 +181,7 @@ Result LottieAnimation::assign(const char* layer, uint32_t ix, const char* var,
     auto loader = PICTURE(pImpl->picture)->loader;
     if (!loader) return Result::InsufficientCondition;
     if (static_cast<LottieLoader*>(loader)->assign(layer, ix, var, val)) {
+        pImpl->invalidate(true);
         PAINT(pImpl->picture)->mark(RenderUpdateFlag::All);
         return Result::Success;
     }
@@ -100,6 +190,43 @@ Result LottieAnimation::assign(const char* layer, uint32_t ix, const char* var,
 }
 
 
+Result LottieAnimation::budget(float time) noexcept
+{
+    if (time < 0.0f) return Result::InvalidArguments;
+
+    auto loader = PICTURE(pImpl->picture)->loader;
+    if (!loader) return Result::InsufficientCondition;
+
+    auto governor = static_cast<LottieGovernor*>(pImpl->monitor);
+
+    if (time == 0.0f) {
+        if (governor) {
+            PICTURE(pImpl->picture)->monitor = nullptr;
+            delete(governor);
+            pImpl->monitor = nullptr;
+        }
+        return Result::Success;
+    }
+
+    if (governor) {
+        governor->budget = time;
+        governor->overruns = governor->headrooms = 0;
+    } else {
+        pImpl->monitor = new LottieGovernor(pImpl->picture, time);
+        PICTURE(pImpl->picture)->monitor = pImpl->monitor;
+    }
+    return Result::Success;
+}
+
+
+uint8_t LottieAnimation::quality() noexcept
+{
+    auto governor = static_cast<LottieGovernor*>(pImpl->monitor);
+    if (!governor) return 100;
+    return 100 - governor->level * 100 / LottieGovernor::MAX_LEVEL;
+}
+
+
 LottieAnimation* LottieAnimation::gen() noexcept
 {
     return new LottieAnimation;
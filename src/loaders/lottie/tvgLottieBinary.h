@@ -0,0 +1,71 @@
+/*
+ * Copyright (c) 2025 the ThorVG project. All rights reserved.
+
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef _TVG_LOTTIE_BINARY_H_
+#define _TVG_LOTTIE_BINARY_H_
+
+#include <cstdint>
+#include <cstring>
+
+/* Pre-tokenized Lottie (.lotb): the json tokens in a flat stream, written by tvg-lottie2bin.
+   The parser reads the tokens without any text scanning and refers to the strings in place,
+   so the data can be used straight from a read-only memory map.
+
+   It is not a compiled model, the tokens are parsed as same as the json text. It is neither portable:
+   the numbers are in the byte order of the writer, the others reject it by the byte order mark and
+   fall back to the json origin. Regenerate it along with the json, not to be distributed alone.
+
+   token layout (the writer's byte order):
+   - Null, False, True, StartObject, EndObject, StartArray, EndArray: [tag]
+   - Int: [tag][int32], Float: [tag][float] (the model keeps the numbers in float)
+   - String, Key: [tag][uint32 length][characters]['\0']
+
+   The "slots" value is kept as a string of its json text, the slots are parsed on demand. */
+
+#define LOTTIE_BINARY_SIGNATURE "TLOT"
+#define LOTTIE_BINARY_VERSION 2          //increase it whenever the layout is changed
+#define LOTTIE_BINARY_BYTE_ORDER 0x0102  //reads 0x0201 in the opposite byte order
+
+enum class LottieToken : uint8_t {Null = 0, False, True, Int, Float, String, Key, StartObject, EndObject, StartArray, EndArray};
+
+struct LottieBinaryHeader
+{
+    char signature[4];
+    uint16_t version;
+    uint16_t order;       //LOTTIE_BINARY_BYTE_ORDER in the writer's byte order
+    //the animation info, available without parsing
+    float frameRate;
+    float startFrame;
+    float endFrame;
+    float w, h;
+};
+
+
+//the data might be unaligned, copy the header out
+static inline bool lottieBinary(const char* data, uint32_t size, LottieBinaryHeader* header = nullptr)
+{
+    if (!data || size < sizeof(LottieBinaryHeader) || memcmp(data, LOTTIE_BINARY_SIGNATURE, 4)) return false;
+    if (header) memcpy(header, data, sizeof(LottieBinaryHeader));
+    return true;
+}
+
+#endif //_TVG_LOTTIE_BINARY_H_
@@ -191,6 +191,42 @@ void LottieBuilder::updateTransform(LottieGroup* parent, LottieObject** child, f
 }
 
 
+//take the scene of the previous frame to rebuild it in place, or a new one if it's already taken in this update
+static Scene* _retain(LottieRetainedScene& retained, uint32_t tick, bool keep = false)
+{
+    if (retained.tick == tick) return Scene::gen();
+    retained.tick = tick;
+
+    if (!retained.scene) {
+        retained.scene = Scene::gen();
+        retained.scene->ref();
+        return retained.scene;
+    }
+
+    auto scene = retained.scene;
+
+    //detach from the previous parent which is not rebuilt in this update
+    if (auto parent = PAINT(scene)->parent) {
+        if (SCENE(parent)->remove(scene) != Result::Success) PAINT(scene)->parent = nullptr;
+    }
+
+    scene->clip(nullptr);
+    scene->mask(nullptr, MaskMethod::None);
+    SCENE(scene)->resetEffects();
+    if (!keep) SCENE(scene)->rewind();
+    return scene;
+}
+
+
+//give up the scene taken in this update
+static void _discard(Scene* scene)
+{
+    if (!scene) return;
+    if (scene->refCnt() == 0) delete(scene);
+    else SCENE(scene)->commit();
+}
+
+
 void LottieBuilder::updateGroup(LottieGroup* parent, LottieObject** child, float frameNo, TVG_UNUSED Inlist<RenderContext>& pcontexts, RenderContext* ctx)
 {
     auto group = static_cast<LottieGroup*>(*child);
@@ -201,7 +237,7 @@ void LottieBuilder::updateGroup(LottieGroup* parent, LottieObject** child, float
     if (group->blendMethod == parent->blendMethod) {
         group->scene = parent->scene;
     } else {
-        group->scene = tvg::Scene::gen();
+        group->scene = _retain(group->retained, tick);
         group->scene->blend(group->blendMethod);
         parent->scene->push(group->scene);
     }
@@ -216,6 +252,8 @@ void LottieBuilder::updateGroup(LottieGroup* parent, LottieObject** child, float
     contexts.back(new RenderContext(*ctx, propagator, group->mergeable()));
 
     updateChildren(group, frameNo, contexts);
+
+    if (group->scene != parent->scene) SCENE(group->scene)->commit();
 }
 
 
@@ -330,12 +368,8 @@ static bool _draw(LottieGroup* parent, LottieShape* shape, RenderContext* ctx)
 {
     if (ctx->merging) return false;
 
-    if (shape) {
-        ctx->merging = shape->pooling();
-        PAINT(ctx->propagator)->duplicate(ctx->merging);
-    } else {
-        ctx->merging = static_cast<Shape*>(ctx->propagator->duplicate());
-    }
+    ctx->merging = shape ? shape->pooling() : parent->pooling();
+    PAINT(ctx->propagator)->duplicate(ctx->merging);
 
     parent->scene->push(ctx->merging);
 
@@ -343,53 +377,77 @@ static bool _draw(LottieGroup* parent, LottieShape* shape, RenderContext* ctx)
 }
 
 
-static void _repeat(LottieGroup* parent, Shape* path, RenderContext* ctx)
+static void _repeat(LottieGroup* parent, LottieShape* source, Shape* path, RenderContext* ctx)
 {
-    Array<Shape*> propagators;
-    propagators.push(ctx->propagator);
-    Array<Shape*> shapes;
+    //a single shape draws all the copies as its instances
+    using Copy = ShapeImpl::Instance;
+
+    Array<Copy> propagators;
+    propagators.push({tvg::identity(), 255});
+    Array<Copy> copies;
+    Array<Copy> instances;
 
     ARRAY_REVERSE_FOREACH(repeater, ctx->repeaters) {
-        shapes.reserve(repeater->cnt);
+        copies.reserve(repeater->cnt * propagators.count);
+
+        Matrix inv;
+        inverse(&repeater->transform, &inv);
 
         for (int i = 0; i < repeater->cnt; ++i) {
             auto multiplier = repeater->offset + static_cast<float>(i);
+            auto opacity = tvg::lerp<uint8_t>(repeater->startOpacity, repeater->endOpacity, static_cast<float>(i + 1) / repeater->cnt);
+
+            auto m = tvg::identity();
+            translate(&m, repeater->position * multiplier + repeater->anchor);
+            scale(&m, {powf(repeater->scale.x * 0.01f, multiplier), powf(repeater->scale.y * 0.01f, multiplier)});
+            rotate(&m, repeater->rotation * multiplier);
+            translateR(&m, -repeater->anchor);
+            m = (repeater->transform * m) * inv;
+
             ARRAY_FOREACH(p, propagators) {
-                auto shape = static_cast<Shape*>((*p)->duplicate());
-                SHAPE(shape)->rs.path = SHAPE(path)->rs.path;
-                auto opacity = tvg::lerp<uint8_t>(repeater->startOpacity, repeater->endOpacity, static_cast<float>(i + 1) / repeater->cnt);
-                shape->opacity(MULTIPLY((*p)->opacity(), opacity));
-
-                auto m = tvg::identity();
-                translate(&m, repeater->position * multiplier + repeater->anchor);
-                scale(&m, {powf(repeater->scale.x * 0.01f, multiplier), powf(repeater->scale.y * 0.01f, multiplier)});
-                rotate(&m, repeater->rotation * multiplier);
-                translateR(&m, -repeater->anchor);
-
-                Matrix inv;
-                inverse(&repeater->transform, &inv);
-                shape->transform((repeater->transform * m) * (inv * shape->transform()));
-                shapes.push(shape);
+                copies.push({m * p->m, MULTIPLY(p->opacity, opacity)});
             }
         }
 
         propagators.clear();
-        propagators.reserve(shapes.count);
+        propagators.reserve(copies.count);
 
         //push repeat shapes in order.
         if (repeater->inorder) {
-            ARRAY_FOREACH(p, shapes) {
-                parent->scene->push(*p);
+            ARRAY_FOREACH(p, copies) {
+                instances.push(*p);
                 propagators.push(*p);
             }
-        } else if (!shapes.empty()) {
-            ARRAY_REVERSE_FOREACH(shape, shapes) {
-                parent->scene->push(*shape);
-                propagators.push(*shape);
+        } else if (!copies.empty()) {
+            ARRAY_REVERSE_FOREACH(p, copies) {
+                instances.push(*p);
+                propagators.push(*p);
             }
         }
-        shapes.clear();
+        copies.clear();
+    }
+
+    if (instances.empty()) return;
+
+    auto repeated = static_cast<Shape*>(ctx->propagator->duplicate());
+    SHAPE(repeated)->rs.path.share(SHAPE(path)->rs.path);
+
+    //the propagator transform is applied to the path prior to the repeaters
+    auto& pm = ctx->propagator->transform();
+    SHAPE(repeated)->inst.reserve(instances.count);
+    ARRAY_FOREACH(p, instances) {
+        SHAPE(repeated)->inst.push({p->m * pm, p->opacity});
     }
+    repeated->transform(tvg::identity());
+
+    //apply it to the one of the previous frame, so that only the changes are updated
+    path->ref();
+    auto shape = source->pooling();
+    path->unref(false);
+    PAINT(repeated)->duplicate(shape);
+    delete(repeated);
+
+    parent->scene->push(shape);
 }
 
 
@@ -433,7 +491,7 @@ void LottieBuilder::updateRect(LottieGroup* parent, LottieObject** child, float
         auto shape = rect->pooling();
         shape->reset();
         appendRect(shape, pos, size, r, rect->clockwise, ctx);
-        _repeat(parent, shape, ctx);
+        _repeat(parent, rect, shape, ctx);
     }
 }
 
@@ -467,8 +525,59 @@ void LottieBuilder::updateEllipse(LottieGroup* parent, LottieObject** child, flo
         auto shape = ellipse->pooling();
         shape->reset();
         _appendCircle(shape, pos, size, ellipse->clockwise, ctx);
-        _repeat(parent, shape, ctx);
+        _repeat(parent, ellipse, shape, ctx);
+    }
+}
+
+
+//the modified path is reused as long as the source, the transform and the modifiers are unchanged
+static bool _pathset(LottiePath* path, float frameNo, RenderPath& out, RenderContext* ctx, Tween& tween, LottieExpressions* exps)
+{
+    //the path data is appended in place, it must not be borrowed one
+    out.detach();
+
+    //plain copy is cheap enough, the expressions and the tweening vary the source at any time
+    if (!ctx->modifier || tween.active || (exps && path->pathset.exp)) {
+        return path->pathset(frameNo, out, ctx->transform, tween, exps, ctx->modifier);
+    }
+
+    auto& cache = path->modified;
+    LottieModifierParams params(ctx->modifier);
+    auto transformed = (ctx->transform != nullptr);
+    auto frames = path->pathset.frames;
+
+    //the frame number matters within the keyframes only
+    auto key = 0.0f;
+    if (frames && frames->count > 1) key = tvg::clamp(frameNo, frames->first().no, frames->last().no);
+
+    if (cache.valid && cache.params == params && cache.frameNo == key && cache.transformed == transformed && (!transformed || cache.transform == *ctx->transform)) {
+        if (out.empty()) out.share(cache.path);
+        else {
+            out.cmds.push(cache.path.cmds);
+            out.pts.push(cache.path.pts);
+        }
+        return true;
+    }
+
+    auto cmdsCnt = out.cmds.count;
+    auto ptsCnt = out.pts.count;
+
+    cache.valid = path->pathset(frameNo, out, ctx->transform, tween, exps, ctx->modifier);
+    if (!cache.valid) return false;
+
+    cache.params = params;
+    cache.frameNo = key;
+    cache.transformed = transformed;
+    if (transformed) cache.transform = *ctx->transform;
+
+    //borrow the whole result, or keep the own copy of the appended one
+    if (cmdsCnt == 0 && ptsCnt == 0) cache.path.share(out);
+    else {
+        cache.path.clear();
+        for (auto i = cmdsCnt; i < out.cmds.count; ++i) cache.path.cmds.push(out.cmds[i]);
+        for (auto i = ptsCnt; i < out.pts.count; ++i) cache.path.pts.push(out.pts[i]);
     }
+    return true;
 }
 
 
@@ -478,14 +587,14 @@ void LottieBuilder::updatePath(LottieGroup* parent, LottieObject** child, float
 
     if (ctx->repeaters.empty()) {
         _draw(parent, path, ctx);
-        if (path->pathset(frameNo, SHAPE(ctx->merging)->rs.path, ctx->transform, tween, exps, ctx->modifier)) {
+        if (_pathset(path, frameNo, SHAPE(ctx->merging)->rs.path, ctx, tween, exps)) {
             PAINT(ctx->merging)->mark(RenderUpdateFlag::Path);
         }
     } else {
         auto shape = path->pooling();
         shape->reset();
-        path->pathset(frameNo, SHAPE(shape)->rs.path, ctx->transform, tween, exps, ctx->modifier);
-        _repeat(parent, shape, ctx);
+        _pathset(path, frameNo, SHAPE(shape)->rs.path, ctx, tween, exps);
+        _repeat(parent, path, shape, ctx);
     }
 }
 
@@ -544,11 +653,11 @@ void LottieBuilder::updateStar(LottiePolyStar* star, float frameNo, Matrix* tran
     }
 
     if (tvg::zero(innerRoundness) && tvg::zero(outerRoundness)) {
-        SHAPE(shape)->rs.path.pts.reserve(numPoints + 2);
-        SHAPE(shape)->rs.path.cmds.reserve(numPoints + 3);
+        SHAPE(shape)->reservePts(numPoints + 2);
+        SHAPE(shape)->reserveCmd(numPoints + 3);
     } else {
-        SHAPE(shape)->rs.path.pts.reserve(numPoints * 3 + 2);
-        SHAPE(shape)->rs.path.cmds.reserve(numPoints + 3);
+        SHAPE(shape)->reservePts(numPoints * 3 + 2);
+        SHAPE(shape)->reserveCmd(numPoints + 3);
         hasRoundness = true;
     }
 
@@ -637,11 +746,11 @@ void LottieBuilder::updatePolygon(LottieGroup* parent, LottiePolyStar* star, flo
     } else {
         shape = merging;
         if (hasRoundness) {
-            SHAPE(shape)->rs.path.pts.reserve(ptsCnt * 3 + 2);
-            SHAPE(shape)->rs.path.cmds.reserve(ptsCnt + 3);
+            SHAPE(shape)->reservePts(ptsCnt * 3 + 2);
+            SHAPE(shape)->reserveCmd(ptsCnt + 3);
         } else {
-            SHAPE(shape)->rs.path.pts.reserve(ptsCnt + 2);
-            SHAPE(shape)->rs.path.cmds.reserve(ptsCnt + 3);
+            SHAPE(shape)->reservePts(ptsCnt + 2);
+            SHAPE(shape)->reserveCmd(ptsCnt + 3);
         }
     }
 
@@ -705,7 +814,7 @@ void LottieBuilder::updatePolystar(LottieGroup* parent, LottieObject** child, fl
         shape->reset();
         if (star->type == LottiePolyStar::Star) updateStar(star, frameNo, (identity ? nullptr : &matrix), shape, ctx, tween, exps);
         else updatePolygon(parent, star, frameNo, (identity  ? nullptr : &matrix), shape, ctx, tween, exps);
-        _repeat(parent, shape, ctx);
+        _repeat(parent, star, shape, ctx);
     }
 }
 
@@ -857,11 +966,36 @@ void LottieBuilder::updatePrecomp(LottieComposition* comp, LottieLayer* precomp,
 
     frameNo = precomp->remap(comp, frameNo, exps);
 
-    ARRAY_REVERSE_FOREACH(c, precomp->children) {
-        auto child = static_cast<LottieLayer*>(*c);
-        if (!child->matteSrc) updateLayer(comp, precomp->scene, child, frameNo);
+    auto content = _retain(precomp->content, tick, true);
+
+    //tweening and expressions may differ per instance
+    auto shareable = !tweening() && !(exps && comp->expressions);
+    PrecompInstance* instance = nullptr;
+
+    if (shareable) {
+        ARRAY_FOREACH(p, instances) {
+            if (p->rid == precomp->rid && p->frameNo == frameNo) {
+                instance = p;
+                break;
+            }
+        }
+    }
+
+    //the same contents are built already, duplicate them rather than building again
+    if (instance) {
+        PAINT(instance->content)->duplicate(content);
+    } else {
+        SCENE(content)->rewind();
+        ARRAY_REVERSE_FOREACH(c, precomp->children) {
+            auto child = static_cast<LottieLayer*>(*c);
+            if (!child->matteSrc) updateLayer(comp, content, child, frameNo);
+        }
+        SCENE(content)->commit();
+        if (shareable) instances.push({content, precomp->rid, frameNo});
     }
 
+    precomp->scene->push(content);
+
     //clip the layer viewport
     auto clipper = precomp->statical.pooling(true);
     clipper->transform(precomp->cache.matrix);
@@ -892,10 +1026,54 @@ void LottieBuilder::updateSolid(LottieLayer* layer)
 void LottieBuilder::updateImage(LottieGroup* layer)
 {
     auto image = static_cast<LottieImage*>(layer->children.first());
+    image->load();
     layer->scene->push(image->pooling(true));
 }
 
 
+static bool _animated(LottieGlyph* glyph)
+{
+    ARRAY_FOREACH(p, glyph->children) {
+        auto group = static_cast<LottieGroup*>(*p);
+        ARRAY_FOREACH(p, group->children) {
+            if (static_cast<LottiePath*>(*p)->pathset.animated()) return true;
+        }
+    }
+    return false;
+}
+
+
+static bool _outline(LottieGlyph* glyph, RenderPath& out, float frameNo, Tween& tween, LottieExpressions* exps)
+{
+    auto ret = false;
+    ARRAY_FOREACH(p, glyph->children) {
+        auto group = static_cast<LottieGroup*>(*p);
+        ARRAY_FOREACH(p, group->children) {
+            if (static_cast<LottiePath*>(*p)->pathset(frameNo, out, nullptr, tween, exps)) ret = true;
+        }
+    }
+    return ret;
+}
+
+
+//the glyph outline rarely varies, build it once and share it with every occurrence of the glyph
+static void _updateGlyph(LottieGlyph* glyph, ShapeImpl* shape, float frameNo, Tween& tween, LottieExpressions* exps)
+{
+    if (!glyph->built) {
+        if (_animated(glyph)) {
+            if (_outline(glyph, shape->rs.path, frameNo, tween, exps)) shape->impl.mark(RenderUpdateFlag::Path);
+            return;
+        }
+        _outline(glyph, glyph->outline, frameNo, tween, exps);
+        glyph->built = true;
+    }
+
+    if (glyph->outline.empty()) return;
+    shape->rs.path.share(glyph->outline);
+    shape->impl.mark(RenderUpdateFlag::Path);
+}
+
+
 //TODO: unify with the updateText() building logic
 static void _fontText(TextDocument& doc, Scene* scene)
 {
@@ -1036,14 +1214,7 @@ void LottieBuilder::updateText(LottieLayer* layer, float frameNo)
                 auto& textGroupMatrix = textGroup->transform();
                 auto shape = text->pooling();
                 shape->reset();
-                ARRAY_FOREACH(p, glyph->children) {
-                    auto group = static_cast<LottieGroup*>(*p);
-                    ARRAY_FOREACH(p, group->children) {
-                        if (static_cast<LottiePath*>(*p)->pathset(frameNo, SHAPE(shape)->rs.path, nullptr, tween, exps)) {
-                            PAINT(shape)->mark(RenderUpdateFlag::Path);
-                        }
-                    }
-                }
+                _updateGlyph(glyph, SHAPE(shape), frameNo, tween, exps);
                 shape->fill(doc.color.r, doc.color.g, doc.color.b);
                 shape->translate(cursor.x - textGroupMatrix.e13, cursor.y - textGroupMatrix.e23);
                 shape->opacity(255);
@@ -1103,7 +1274,7 @@ void LottieBuilder::updateText(LottieLayer* layer, float frameNo)
                     }
 
                     // TextGroup transformation is performed once
-                    if (textGroup->paints().size() == 0 && needGroup) {
+                    if (SCENE(textGroup)->paints.empty() && needGroup) {
                         tvg::identity(&textGroupMatrix);
                         translate(&textGroupMatrix, cursor);
 
@@ -1177,20 +1348,36 @@ void LottieBuilder::updateText(LottieLayer* layer, float frameNo)
 }
 
 
-void LottieBuilder::updateMasks(LottieLayer* layer, float frameNo)
+//the masks intersecting the first one can be replaced with the nested clippers
+static bool _clippable(Array<LottieMask*>& masks, float frameNo)
 {
-    if (layer->masks.count == 0) return;
+    auto first = true;
+    ARRAY_FOREACH(p, masks) {
+        auto mask = *p;
+        if (mask->method == MaskMethod::None) continue;
+        if (first) {
+            if (mask->method == MaskMethod::Subtract || mask->method == MaskMethod::InvAlpha) return false;
+            first = false;
+        } else if (mask->method != MaskMethod::Intersect || mask->opacity(frameNo) < 255) return false;
+    }
+    return true;
+}
 
-    //Introduce an intermediate scene for embracing matte + masking or precomp clipping + masking replaced by clipping
-    if (layer->matteTarget || layer->type == LottieLayer::Precomp) {
-        auto scene = Scene::gen();
-        scene->push(layer->scene);
-        layer->scene = scene;
+
+void LottieBuilder::updateMasks(LottieLayer* layer, Scene* wrapper, uint8_t base, float frameNo)
+{
+    if (wrapper) {
+        layer->scene->opacity(base);
+        wrapper->push(layer->scene);
+        SCENE(wrapper)->commit();
+        layer->scene = wrapper;
+        base = 255;
     }
 
     Shape* pShape = nullptr;
     MaskMethod pMethod;
     uint8_t pOpacity;
+    auto clipping = _clippable(layer->masks, frameNo);
 
     ARRAY_FOREACH(p, layer->masks) {
         auto mask = *p;
@@ -1202,21 +1389,27 @@ void LottieBuilder::updateMasks(LottieLayer* layer, float frameNo)
 
         //the first mask
         if (!pShape) {
-            pShape = layer->pooling();
-            SHAPE(pShape)->reset();
+            pShape = mask->pooling();
+            pShape->reset();
+            pShape->mask(nullptr, MaskMethod::None);
+            pShape->clip(nullptr);
             auto compMethod = (method == MaskMethod::Subtract || method == MaskMethod::InvAlpha) ? MaskMethod::InvAlpha : MaskMethod::Alpha;
             //Cheaper. Replace the masking with a clipper
-            if (layer->masks.count == 1 && compMethod == MaskMethod::Alpha) {
-                layer->scene->opacity(MULTIPLY(layer->scene->opacity(), opacity));
+            if (clipping) {
+                base = MULTIPLY(base, opacity);
                 layer->scene->clip(pShape);
             } else {
                 layer->scene->mask(pShape, compMethod);
             }
         //Chain mask composition
         } else if (pMethod != method || pOpacity != opacity || (method != MaskMethod::Subtract && method != MaskMethod::Difference)) {
-            auto shape = layer->pooling();
-            SHAPE(shape)->reset();
-            pShape->mask(shape, method);
+            auto shape = mask->pooling();
+            shape->reset();
+            shape->mask(nullptr, MaskMethod::None);
+            shape->clip(nullptr);
+            //the intersection of the clippers is the clipper of the clipper
+            if (clipping) pShape->clip(shape);
+            else pShape->mask(shape, method);
             pShape = shape;
         }
 
@@ -1235,6 +1428,39 @@ void LottieBuilder::updateMasks(LottieLayer* layer, float frameNo)
         pOpacity = opacity;
         pMethod = method;
     }
+
+    layer->scene->opacity(base);
+}
+
+
+//the single opaque shape of the matte source which draws the same alpha as the whole source does
+static Shape* _matteShape(Paint* paint, Matrix& m)
+{
+    auto impl = PAINT(paint);
+    if (impl->hidden || impl->opacity < 255 || impl->blendMethod != BlendMethod::Normal || impl->maskData || impl->clipper) return nullptr;
+
+    m = m * paint->transform();
+
+    if (paint->type() == Type::Shape) {
+        auto shape = SHAPE(paint);
+        auto& rs = shape->rs;
+        if (rs.fill || rs.color.a < 255 || rs.trimpath() || !shape->inst.empty()) return nullptr;
+        if (rs.stroke && rs.stroke->width > 0.0f && (rs.stroke->fill || rs.stroke->color.a > 0)) return nullptr;
+        return static_cast<Shape*>(paint);
+    }
+
+    if (paint->type() != Type::Scene) return nullptr;
+
+    auto scene = SCENE(paint);
+    if (scene->effects && !scene->effects->empty()) return nullptr;
+
+    Paint* child = nullptr;
+    ARRAY_FOREACH(p, scene->paints) {
+        if ((*p)->opacity() == 0) continue;
+        if (child) return nullptr;  //overlapped paths can't be merged into a clipper
+        child = *p;
+    }
+    return child ? _matteShape(child, m) : nullptr;
 }
 
 
@@ -1246,11 +1472,23 @@ bool LottieBuilder::updateMatte(LottieComposition* comp, float frameNo, Scene* s
     updateLayer(comp, scene, target, frameNo);
 
     if (target->scene) {
+        //Cheaper. Replace the alpha matte of a single opaque shape with a clipper (precomp clips its viewport instead)
+        if (layer->matteType == MaskMethod::Alpha && layer->type != LottieLayer::Precomp && layer->effects.empty()) {
+            auto m = tvg::identity();
+            if (auto shape = _matteShape(target->scene, m)) {
+                auto clipper = target->pooling();
+                SHAPE(clipper)->reset();
+                SHAPE(clipper)->rs.path.share(SHAPE(shape)->rs.path);
+                clipper->fillRule(shape->fillRule());
+                clipper->transform(m);
+                layer->scene->clip(clipper);
+                _discard(target->scene);
+                return true;
+            }
+        }
         layer->scene->mask(target->scene, layer->matteType);
     } else if (layer->matteType == MaskMethod::Alpha || layer->matteType == MaskMethod::Luma) {
         //matte target is not exist. alpha blending definitely bring an invisible result
-        delete(layer->scene);
-        layer->scene = nullptr;
         return false;
     }
     return true;
@@ -1317,6 +1555,9 @@ void LottieBuilder::updateEffect(LottieLayer* layer, float frameNo)
 
     if (layer->effects.count == 0) return;
 
+    //a single pass of the box blur under the frame time budget
+    auto quality = (degrade >= Degrade::Effects) ? 1 : QUALITY;
+
     ARRAY_FOREACH(p, layer->effects) {
         if (!(*p)->enable) continue;
         switch ((*p)->type) {
@@ -1350,12 +1591,12 @@ void LottieBuilder::updateEffect(LottieLayer* layer, float frameNo)
                 auto effect = static_cast<LottieFxDropShadow*>(*p);
                 auto color = effect->color(frameNo);
                 //seems the opacity range in dropshadow is 0 ~ 256
-                layer->scene->push(SceneEffect::DropShadow, color.r, color.g, color.b, std::min(255, (int)effect->opacity(frameNo)), (double)effect->angle(frameNo), double(effect->distance(frameNo) * 0.5f), (double)(effect->blurness(frameNo) * BLUR_TO_SIGMA), QUALITY);
+                layer->scene->push(SceneEffect::DropShadow, color.r, color.g, color.b, std::min(255, (int)effect->opacity(frameNo)), (double)effect->angle(frameNo), double(effect->distance(frameNo) * 0.5f), (double)(effect->blurness(frameNo) * BLUR_TO_SIGMA), quality);
                 break;
             }
             case LottieEffect::GaussianBlur: {
                 auto effect = static_cast<LottieFxGaussianBlur*>(*p);
-                layer->scene->push(SceneEffect::GaussianBlur, (double)(effect->blurness(frameNo) * BLUR_TO_SIGMA), effect->direction(frameNo) - 1, effect->wrap(frameNo), QUALITY);
+                layer->scene->push(SceneEffect::GaussianBlur, (double)(effect->blurness(frameNo) * BLUR_TO_SIGMA), effect->direction(frameNo) - 1, effect->wrap(frameNo), quality);
                 break;
             }
             default: break;
@@ -1376,16 +1617,27 @@ void LottieBuilder::updateLayer(LottieComposition* comp, Scene* scene, LottieLay
     //full transparent scene. no need to perform
     if (layer->type != LottieLayer::Null && layer->cache.opacity == 0) return;
 
-    //Prepare render data
-    layer->scene = Scene::gen();
-    layer->scene->id = layer->id;
+    //hardly visible, drop it under the frame time budget (the matte sources decide the visibility of the others)
+    constexpr uint8_t FAINT = 13;  //5%
+    if (degrade >= Degrade::FaintLayers && layer->type != LottieLayer::Null && !layer->matteSrc && layer->cache.opacity < FAINT) return;
 
-    //ignore opacity when Null layer?
-    if (layer->type != LottieLayer::Null) layer->scene->opacity(layer->cache.opacity);
+    //Prepare render data, the scenes of the previous frame are rebuilt in place
+    //Introduce an intermediate scene for embracing matte + masking or precomp clipping + masking replaced by clipping
+    auto wrapper = (layer->masks.count > 0 && (layer->matteTarget || layer->type == LottieLayer::Precomp)) ? _retain(layer->wrapper, tick) : nullptr;
+
+    //the static contents are kept in the retained scene as they were built
+    auto reuse = layer->built && layer->retained.tick != tick;
 
+    layer->scene = _retain(layer->retained, tick, reuse);
+    layer->scene->id = layer->id;
     layer->scene->transform(layer->cache.matrix);
 
-    if (!updateMatte(comp, frameNo, scene, layer)) return;
+    if (!updateMatte(comp, frameNo, scene, layer)) {
+        _discard(layer->scene);
+        _discard(wrapper);
+        layer->scene = nullptr;
+        return;
+    }
 
     switch (layer->type) {
         case LottieLayer::Precomp: {
@@ -1406,23 +1658,133 @@ void LottieBuilder::updateLayer(LottieComposition* comp, Scene* scene, LottieLay
             break;
         }
         default: {
+            if (reuse) break;
             if (!layer->children.empty()) {
                 Inlist<RenderContext> contexts;
                 contexts.back(new RenderContext(layer->pooling()));
                 updateChildren(layer, frameNo, contexts);
                 contexts.free();
             }
+            if (layer->scene == layer->retained.scene) layer->built = layer->fixed;
             break;
         }
     }
 
-    updateMasks(layer, frameNo);
+    SCENE(layer->scene)->commit();
 
-    layer->scene->blend(layer->blendMethod);
+    //ignore opacity when Null layer?
+    updateMasks(layer, wrapper, (layer->type == LottieLayer::Null) ? 255 : layer->cache.opacity, frameNo);
+
+    //the blending requires the composition of the layer
+    layer->scene->blend((degrade >= Degrade::Blending) ? BlendMethod::Normal : layer->blendMethod);
 
     updateEffect(layer, frameNo);
 
-    if (!layer->matteSrc) scene->push(layer->scene);
+    if (scene && !layer->matteSrc) scene->push(layer->scene);
+}
+
+
+//build the queued layers with the scratch data of this builder until nothing is left
+void LottieBuilder::updateQueue(LottieBuildQueue& queue)
+{
+    if (!queue.open) return;
+
+    tick = queue.tick;
+    degrade = queue.degrade;
+    instances.clear();
+
+    while (true) {
+        auto idx = queue.next++;
+        if (idx >= queue.layers.count) break;
+        if (auto layer = queue.layers[idx]) {
+            updateLayer(queue.comp, nullptr, layer, queue.frameNo);
+        //the dependent layers are built in order by one
+        } else {
+            ARRAY_REVERSE_FOREACH(child, queue.comp->root->children) {
+                auto layer = static_cast<LottieLayer*>(*child);
+                if (!layer->matteSrc && !layer->isolated) updateLayer(queue.comp, nullptr, layer, queue.frameNo);
+            }
+        }
+    }
+}
+
+
+//wait for the helpers which have taken part in the update, the others are still in the task queue
+static void _reclaim(Array<LottieBuildWorker*>& workers)
+{
+    ARRAY_FOREACH(p, workers) {
+        auto worker = *p;
+        if (worker->requested && worker->started) {
+            worker->done();
+            worker->requested = false;
+        }
+    }
+}
+
+
+//build the isolated top-level layers concurrently, then push them in the original order
+bool LottieBuilder::updateLayers(LottieComposition* comp, float frameNo)
+{
+    //tweening and expressions are stateful, build them in order
+    if (TaskScheduler::threads() < 2 || tweening() || (exps && comp->expressions)) return false;
+
+    auto& layers = queue.layers;
+    auto bundle = false;
+    layers.clear();
+
+    ARRAY_REVERSE_FOREACH(child, comp->root->children) {
+        auto layer = static_cast<LottieLayer*>(*child);
+        if (layer->matteSrc) continue;
+        if (layer->isolated) layers.push(layer);
+        else bundle = true;
+    }
+
+    //put the bundle of the dependent layers first, it likely takes the longest
+    if (bundle) {
+        layers.push(nullptr);
+        std::swap(layers.first(), layers.last());
+    }
+
+    if (layers.count < 2) return false;
+
+    //the parent layers are shared, figure out their transforms in advance
+    ARRAY_FOREACH(child, comp->root->children) {
+        auto layer = static_cast<LottieLayer*>(*child);
+        if (frameNo >= layer->inFrame && frameNo < layer->outFrame) updateTransform(layer, frameNo);
+    }
+
+    queue.comp = comp;
+    queue.frameNo = frameNo;
+    queue.tick = tick;
+    queue.degrade = degrade;
+    queue.next = 0;
+    queue.open = true;
+
+    _reclaim(workers);
+
+    auto cnt = std::min(TaskScheduler::threads(), layers.count - 1);
+    while (workers.count < cnt) workers.push(new LottieBuildWorker(this));
+
+    for (uint32_t i = 0; i < cnt; ++i) {
+        auto worker = workers[i];
+        if (worker->requested) continue;  //it joins in once started
+        worker->started = false;
+        worker->requested = true;
+        TaskScheduler::request(worker);
+    }
+
+    updateQueue(queue);
+
+    queue.open = false;
+
+    _reclaim(workers);
+
+    ARRAY_REVERSE_FOREACH(child, comp->root->children) {
+        auto layer = static_cast<LottieLayer*>(*child);
+        if (!layer->matteSrc && layer->scene) comp->root->scene->push(layer->scene);
+    }
+
+    return true;
 }
 
 
@@ -1444,6 +1806,138 @@ static void _buildReference(LottieComposition* comp, LottieLayer* layer)
 }
 
 
+static bool _contains(LottieGroup* group, LottieObject* target)
+{
+    ARRAY_FOREACH(p, group->children) {
+        if (*p == target) return true;
+        if (((*p)->type == LottieObject::Group || (*p)->type == LottieObject::Layer) && _contains(static_cast<LottieGroup*>(*p), target)) return true;
+    }
+    return false;
+}
+
+
+//static contents have no animated properties, the slots invalidate them on overriding
+static bool _fixed(LottieLayer* layer)
+{
+    return layer->type == LottieLayer::Shape && !layer->animated();
+}
+
+
+//the overridden objects might turn the static contents into the animated ones, build them again
+static void _invalidate(LottieGroup* parent, LottieSlot* slot)
+{
+    ARRAY_FOREACH(p, parent->children) {
+        auto layer = static_cast<LottieLayer*>(*p);
+        if (layer->type != LottieLayer::Shape) continue;
+        ARRAY_FOREACH(pair, slot->pairs) {
+            if (!_contains(layer, pair->obj)) continue;
+            layer->fixed = _fixed(layer);
+            layer->built = false;
+            break;
+        }
+    }
+}
+
+
+//collect the assets and the matte sources built along with the layer, the text and image layers access the shared resources
+static void _dependencies(LottieComposition* comp, LottieLayer* layer, Array<LottieObject*>& deps, bool& isolated)
+{
+    if (layer->type == LottieLayer::Text || layer->type == LottieLayer::Image) isolated = false;
+
+    if (auto target = layer->matteTarget) {
+        deps.push(target);
+        _dependencies(comp, target, deps, isolated);
+    }
+
+    if (layer->type != LottieLayer::Precomp) return;
+
+    ARRAY_FOREACH(p, comp->assets) {
+        if (layer->rid != (*p)->id) continue;
+        deps.push(*p);
+        break;
+    }
+
+    ARRAY_FOREACH(p, layer->children) {
+        _dependencies(comp, static_cast<LottieLayer*>(*p), deps, isolated);
+    }
+}
+
+
+//figure out the top-level layers sharing nothing with the others, those can be built concurrently
+static void _isolate(LottieComposition* comp)
+{
+    Array<LottieObject*> deps;
+    Array<LottieLayer*> owners;
+
+    ARRAY_FOREACH(p, comp->root->children) {
+        auto layer = static_cast<LottieLayer*>(*p);
+        if (layer->matteSrc) continue;
+        layer->isolated = true;
+        _dependencies(comp, layer, deps, layer->isolated);
+        while (owners.count < deps.count) owners.push(layer);
+    }
+
+    for (uint32_t i = 0; i < deps.count; ++i) {
+        for (uint32_t j = i + 1; j < deps.count; ++j) {
+            if (deps[i] == deps[j] && owners[i] != owners[j]) owners[i]->isolated = owners[j]->isolated = false;
+        }
+    }
+}
+
+
+//the image assets shown by the image layers of the composition
+static void _images(LottieLayer* parent, Array<LottieObject*>& images)
+{
+    ARRAY_FOREACH(p, parent->children) {
+        auto layer = static_cast<LottieLayer*>(*p);
+        if (layer->type == LottieLayer::Image && !layer->children.empty()) images.push(layer->children.first());
+    }
+}
+
+
+//the slots keep the objects to override, those must stay alive
+static bool _slotted(LottieComposition* comp, LottieObject* asset)
+{
+    auto group = (asset->type == LottieObject::Layer) ? static_cast<LottieGroup*>(asset) : nullptr;
+
+    ARRAY_FOREACH(p, comp->slots) {
+        auto slot = *p;
+        if (slot->context.layer == asset || (group && _contains(group, slot->context.layer))) return true;
+        ARRAY_FOREACH(pair, slot->pairs) {
+            if (pair->obj == asset || (group && _contains(group, pair->obj))) return true;
+        }
+    }
+    return false;
+}
+
+
+//drop the assets no layer refers to, those would be never built nor shown
+static void _prune(LottieComposition* comp)
+{
+    Array<LottieObject*> images;
+    _images(comp->root, images);
+
+    ARRAY_FOREACH(p, comp->assets) {
+        if ((*p)->type == LottieObject::Layer && static_cast<LottieLayer*>(*p)->buildDone) _images(static_cast<LottieLayer*>(*p), images);
+    }
+
+    auto used = comp->assets.begin();
+    ARRAY_FOREACH(p, comp->assets) {
+        auto asset = *p;
+        auto referenced = false;
+        if (asset->type == LottieObject::Layer) referenced = static_cast<LottieLayer*>(asset)->buildDone;
+        else {
+            ARRAY_FOREACH(image, images) {
+                if (*image == asset) referenced = true;
+            }
+        }
+        if (referenced || _slotted(comp, asset)) *used++ = asset;
+        else delete(asset);
+    }
+    comp->assets.count = used - comp->assets.begin();
+}
+
+
 static void _buildHierarchy(LottieGroup* parent, LottieLayer* child)
 {
     if (child->pix == -1) return;
@@ -1521,6 +2015,9 @@ static bool _buildComposition(LottieComposition* comp, LottieLayer* parent)
 
         //attach the necessary font data
         if (child->type == LottieLayer::Text) _attachFont(comp, child);
+
+        //figure out the contents to be built only once
+        child->fixed = _fixed(child);
     }
     return true;
 }
@@ -1530,6 +2027,23 @@ static bool _buildComposition(LottieComposition* comp, LottieLayer* parent)
 /* External Class Implementation                                        */
 /************************************************************************/
 
+void LottieBuildWorker::run(TVG_UNUSED unsigned tid)
+{
+    started = true;
+    builder.updateQueue(owner->queue);
+}
+
+
+LottieBuilder::~LottieBuilder()
+{
+    ARRAY_FOREACH(p, workers) {
+        (*p)->done();
+        delete(*p);
+    }
+    if (exps) LottieExpressions::retrieve(exps);
+}
+
+
 bool LottieBuilder::update(LottieComposition* comp, float frameNo)
 {
     if (comp->root->children.empty()) return false;
@@ -1542,15 +2056,47 @@ bool LottieBuilder::update(LottieComposition* comp, float frameNo)
         if (equal(frameNo, tween.frameNo)) offTween();
     }
 
-    if (exps && comp->expressions) exps->update(comp->timeAtFrame(frameNo));
+    if (exps && comp->expressions) {
+        //the engine might be shared with the other loaders, occupy it during the update.
+        //the layers with expressions are never handed to the build workers (see updateLayers()),
+        //so the whole rebuild runs on this thread and the workers never wait for this key.
+        ScopedLock lock(exps->key);
+        exps->update(comp->timeAtFrame(frameNo));
+        rebuild(comp, frameNo);
+    } else rebuild(comp, frameNo);
+
+    return true;
+}
+
+
+//rebuild the previous frame in place, only the changes are updated
+void LottieBuilder::rebuild(LottieComposition* comp, float frameNo)
+{
+    ++tick;
+    instances.clear();
+    SCENE(comp->root->scene)->rewind();
 
     //update children layers
-    ARRAY_REVERSE_FOREACH(child, comp->root->children) {
-        auto layer = static_cast<LottieLayer*>(*child);
-        if (!layer->matteSrc) updateLayer(comp, comp->root->scene, layer, frameNo);
+    if (!updateLayers(comp, frameNo)) {
+        ARRAY_REVERSE_FOREACH(child, comp->root->children) {
+            auto layer = static_cast<LottieLayer*>(*child);
+            if (!layer->matteSrc) updateLayer(comp, comp->root->scene, layer, frameNo);
+        }
     }
 
-    return true;
+    SCENE(comp->root->scene)->commit();
+}
+
+
+//only the layers containing the overridden objects are built again, the others keep their contents
+void LottieBuilder::invalidate(LottieComposition* comp, LottieSlot* slot)
+{
+    _invalidate(comp->root, slot);
+
+    //the precomp layers share the children of the assets
+    ARRAY_FOREACH(p, comp->assets) {
+        if ((*p)->type == LottieObject::Layer) _invalidate(static_cast<LottieLayer*>(*p), slot);
+    }
 }
 
 
@@ -1561,6 +2107,8 @@ void LottieBuilder::build(LottieComposition* comp)
     comp->root->scene = Scene::gen();
 
     _buildComposition(comp, comp->root);
+    _prune(comp);
+    _isolate(comp);
 
     if (!update(comp, 0)) return;
 
@@ -1568,7 +2116,4 @@ void LottieBuilder::build(LottieComposition* comp)
     auto clip = Shape::gen();
     clip->appendRect(0, 0, comp->w, comp->h);
     comp->root->scene->clip(clip);
-
-    //turn off partial rendering for children
-    SCENE(comp->root->scene)->size({comp->w, comp->h});
 }
\ No newline at end of file
@@ -23,13 +23,17 @@
 #ifndef _TVG_LOTTIE_BUILDER_H_
 #define _TVG_LOTTIE_BUILDER_H_
 
+#include <atomic>
 #include "tvgCommon.h"
 #include "tvgInlist.h"
+#include "tvgTaskScheduler.h"
 #include "tvgShape.h"
 #include "tvgLottieExpressions.h"
 #include "tvgLottieModifier.h"
 
 struct LottieComposition;
+struct LottieSlot;
+struct LottieBuildWorker;
 
 struct RenderRepeater
 {
@@ -47,6 +51,13 @@ struct RenderRepeater
 
 enum RenderFragment : uint8_t {ByNone = 0, ByFill, ByStroke};
 
+struct PrecompInstance
+{
+    Scene* content;       //built contents of the precomp
+    unsigned long rid;    //precomp reference id
+    float frameNo;        //remapped frame number
+};
+
 struct RenderContext
 {
     INLIST_ITEM(RenderContext);
@@ -104,18 +115,31 @@ struct RenderContext
     }
 };
 
+//the top-level layers to be built concurrently in the current update
+struct LottieBuildQueue
+{
+    Array<LottieLayer*> layers;  //nullptr stands for the bundle of the layers depending on the others
+    LottieComposition* comp = nullptr;
+    float frameNo = 0.0f;
+    uint32_t tick = 0;
+    uint8_t degrade = 0;
+    atomic<uint32_t> next{};
+    atomic<bool> open{};
+};
+
 struct LottieBuilder
 {
-    LottieBuilder()
-    {
-        exps = LottieExpressions::instance();
-    }
+    //the reduction steps of the rendering costs, each one includes the previous ones
+    //(no steps for the matte resolution and the anti-aliasing, the engines composite and rasterize them at full quality always)
+    enum Degrade : uint8_t {None = 0, Effects, Blending, FaintLayers};
 
-    ~LottieBuilder()
+    LottieBuilder(bool expressions = true)
     {
-        LottieExpressions::retrieve(exps);
+        if (expressions) exps = LottieExpressions::instance();
     }
 
+    ~LottieBuilder();
+
     bool expressions()
     {
         return exps ? true : false;
@@ -138,8 +162,14 @@ struct LottieBuilder
         return tween.active;
     }
 
+    void reduce(uint8_t level)
+    {
+        degrade = level;
+    }
+
     bool update(LottieComposition* comp, float progress);
     void build(LottieComposition* comp);
+    void invalidate(LottieComposition* comp, LottieSlot* slot);
 
 private:
     void appendRect(Shape* shape, Point& pos, Point& size, float r, bool clockwise, RenderContext* ctx);
@@ -148,13 +178,16 @@ private:
     void updateStrokeEffect(LottieLayer* layer, LottieFxStroke* effect, float frameNo);
     void updateEffect(LottieLayer* layer, float frameNo);
     void updateLayer(LottieComposition* comp, Scene* scene, LottieLayer* layer, float frameNo);
+    bool updateLayers(LottieComposition* comp, float frameNo);
+    void rebuild(LottieComposition* comp, float frameNo);
+    void updateQueue(LottieBuildQueue& queue);
     bool updateMatte(LottieComposition* comp, float frameNo, Scene* scene, LottieLayer* layer);
     void updatePrecomp(LottieComposition* comp, LottieLayer* precomp, float frameNo);
     void updatePrecomp(LottieComposition* comp, LottieLayer* precomp, float frameNo, Tween& tween);
     void updateSolid(LottieLayer* layer);
     void updateImage(LottieGroup* layer);
     void updateText(LottieLayer* layer, float frameNo);
-    void updateMasks(LottieLayer* layer, float frameNo);
+    void updateMasks(LottieLayer* layer, Scene* wrapper, uint8_t base, float frameNo);
     void updateTransform(LottieLayer* layer, float frameNo);
     void updateChildren(LottieGroup* parent, float frameNo, Inlist<RenderContext>& contexts);
     void updateGroup(LottieGroup* parent, LottieObject** child, float frameNo, Inlist<RenderContext>& pcontexts, RenderContext* ctx);
@@ -175,8 +208,30 @@ private:
     void updateOffsetPath(LottieGroup* parent, LottieObject** child, float frameNo, Inlist<RenderContext>& contexts, RenderContext* ctx);
 
     RenderPath buffer;   //resusable path
-    LottieExpressions* exps;
+    LottieExpressions* exps = nullptr;
     Tween tween;
+    uint32_t tick = 0;   //the update count, to figure out the retained scenes taken in the current update
+    uint8_t degrade = Degrade::None;   //the quality reduction under the frame time budget
+    Array<PrecompInstance> instances;  //the precomps built in the current update, to be shared with the others
+    Array<LottieBuildWorker*> workers;  //the helpers building the isolated layers on the other threads
+    LottieBuildQueue queue;
+
+    friend struct LottieBuildWorker;
+};
+
+
+//a helper building the queued layers with its own scratch data
+struct LottieBuildWorker : Task
+{
+    LottieBuilder* owner;
+    LottieBuilder builder{false};
+    atomic<bool> started{};  //started to build in the requested run
+    bool requested = false;  //requested and not waited yet
+
+    LottieBuildWorker(LottieBuilder* owner) : owner(owner) {}
+
+protected:
+    void run(unsigned tid) override;
 };
 
 #endif //_TVG_LOTTIE_BUILDER_H
\ No newline at end of file
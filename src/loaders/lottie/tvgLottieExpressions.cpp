@@ -23,11 +23,15 @@
 
 #include "tvgMath.h"
 #include "tvgCompressor.h"
+#include "tvgTaskScheduler.h"
 #include "tvgLottieModel.h"
 #include "tvgLottieExpressions.h"
 
 #ifdef THORVG_LOTTIE_EXPRESSIONS_SUPPORT
 
+#include "jerry-config.h"
+#include "jerryscript-port.h"
+
 /************************************************************************/
 /* Internal Class Implementation                                        */
 /************************************************************************/
@@ -43,6 +47,33 @@ struct ExpContent
     size_t refCnt;
 };
 
+//the context objects of a layer, shared by the expressions of the layer
+struct ExpScope
+{
+    LottieLayer* layer;         //the owner
+    jerry_value_t self;         //thisLayer
+    jerry_value_t comp;         //thisComp
+    jerry_value_t main;         //comp(name)
+    ExpContent* contents[3];    //the layer, its composition and the root, updated per evaluation
+    uint32_t refCnt;            //the scripts in the scope
+};
+
+//the compiled code and its property object, built once and reused on every evaluation
+struct ExpScript
+{
+    jerry_value_t code;         //a function taking the context values and the used members of thisProperty
+    jerry_value_t property;     //thisProperty
+    uint32_t members;           //the bits of the members bound as the parameters (EXP_MEMBERS)
+    uint32_t writableCnt;       //the writables bound as the last parameters
+    ExpContent* object;         //bound to the property object, the frame number is updated per evaluation
+    ExpScope* scope;
+    LottieExpression* exp;
+    LottieExpressions* engine;  //the owner of the values above
+    jerry_value_t result;       //the last result, valid in the same frame (tick, frameNo)
+    uint32_t tick;
+    float frameNo;
+};
+
 static jerry_value_t _content(const jerry_call_info_t* info, const jerry_value_t args[], const jerry_length_t argsCnt);
 
 //reserved expressions specifiers
@@ -59,7 +90,20 @@ static const char* EXP_VALUE = "value";
 static const char* EXP_INDEX = "index";
 static const char* EXP_EFFECT= "effect";
 
-static LottieExpressions* exps = nullptr;   //singleton instance engine
+//the members of thisProperty, they are bound as the parameters if the code refers to them
+static const char* EXP_MEMBERS[] = {
+    EXP_VALUE, "valueAtTime", "velocity", "velocityAtTime", "speed", "speedAtTime", "wiggle", "temporalWiggle", "propertyGroup",
+    "loopIn", "loopOut", "loopInDuration", "loopOutDuration", "key", "nearestKey", "numKeys", EXP_CONTENT, EXP_EFFECT,
+    "transform", "points", "inTangents", "outTangents", "isClosed"
+};
+static constexpr uint32_t EXP_MEMBER_CNT = sizeof(EXP_MEMBERS) / sizeof(EXP_MEMBERS[0]);
+
+static Array<LottieExpressions*> engines;    //a context per worker thread at most, shared by the loaders
+static Key engineKey;                        //guards the engines
+static thread_local jerry_context_t* current = nullptr;   //the active context of this thread
+
+//the compiled scripts retained per engine, the others are compiled per evaluation. They live in the fixed heap (JERRY_GLOBAL_HEAP_SIZE)
+static constexpr uint32_t EXP_SCRIPT_CAP = 64;
 
 
 static ExpContent* _expcontent(LottieExpression* exp, float frameNo, void* obj, size_t refCnt = 1)
@@ -147,7 +191,6 @@ static void contentFree(void *native_p, struct jerry_object_native_info_t *info_
 }
 
 static jerry_object_native_info_t freeCb {contentFree, 0, 0};
-static uint32_t engineRefCnt = 0;  //Expressions Engine reference count
 
 
 static char* _name(jerry_value_t args)
@@ -332,8 +375,11 @@ static jerry_value_t _effect(const jerry_call_info_t* info, const jerry_value_t
 }
 
 
-static void _buildLayer(jerry_value_t context, float frameNo, LottieLayer* layer, LottieLayer* comp, LottieExpression* exp)
+static void _buildLayer(jerry_value_t context, ExpContent* data, LottieLayer* comp)
 {
+    auto layer = static_cast<LottieLayer*>(data->obj);
+    auto exp = data->exp;
+
     auto width = jerry_number(layer->w);
     jerry_object_set_sz(context, EXP_WIDTH, width);
     jerry_value_free(width);
@@ -388,7 +434,7 @@ static void _buildLayer(jerry_value_t context, float frameNo, LottieLayer* layer
 
     //sampleImage(point, radius = [.5, .5], postEffect=true, t=time)
 
-    _buildTransform(context, frameNo, layer->transform);
+    _buildTransform(context, data->frameNo, layer->transform);
 
     //audioLevels, #the value of the Audio Levels property of the layer in decibels
 
@@ -414,16 +460,14 @@ static void _buildLayer(jerry_value_t context, float frameNo, LottieLayer* layer
     jerry_value_free(toComp);
 
     //content("name"), #look for the named property from a layer
-    auto data = _expcontent(exp, frameNo, layer, 2);
-
     auto content = jerry_function_external(_content);
     jerry_object_set_sz(context, EXP_CONTENT, content);
-    jerry_object_set_native_ptr(content, &freeCb, data);
+    jerry_object_set_native_ptr(content, &freeCb, _expcontent(data));
     jerry_value_free(content);
 
     auto effect = jerry_function_external(_effect);
     jerry_object_set_sz(context, EXP_EFFECT, effect);
-    jerry_object_set_native_ptr(effect, &freeCb, data);
+    jerry_object_set_native_ptr(effect, &freeCb, _expcontent(data));
     jerry_value_free(effect);
 }
 
@@ -663,11 +707,7 @@ static jerry_value_t _layer(const jerry_call_info_t* info, const jerry_value_t a
 
     if (!layer) return jerry_undefined();
 
-    auto obj = jerry_object();
-    jerry_object_set_native_ptr(obj, nullptr, layer);
-    _buildLayer(obj, data->frameNo, layer, comp, data->exp);
-
-    return obj;
+    return data->exp->script->engine->layer(layer, comp, data->exp, data->frameNo);
 }
 
 
@@ -1037,11 +1077,10 @@ static void _buildPath(jerry_value_t context, LottieExpression* exp)
 }
 
 
-static void _buildProperty(float frameNo, jerry_value_t context, LottieExpression* exp)
+//the value is updated per evaluation
+static void _buildProperty(jerry_value_t context, ExpContent* layer, ExpContent* object)
 {
-    auto value = _value(frameNo, exp->property);
-    jerry_object_set_sz(context, EXP_VALUE, value);
-    jerry_value_free(value);
+    auto exp = layer->exp;
 
     auto valueAtTime = jerry_function_external(_valueAtTime);
     jerry_object_set_sz(context, "valueAtTime", valueAtTime);
@@ -1066,26 +1105,22 @@ static void _buildProperty(float frameNo, jerry_value_t context, LottieExpressio
     jerry_object_set_native_ptr(speedAtTime, nullptr, exp);
     jerry_value_free(speedAtTime);
 
-    {
-        auto data =  _expcontent(exp, frameNo, exp->object, 3);
-
-        auto wiggle = jerry_function_external(_wiggle);
-        jerry_object_set_sz(context, "wiggle", wiggle);
-        jerry_object_set_native_ptr(wiggle, &freeCb, data);
-        jerry_value_free(wiggle);
+    auto wiggle = jerry_function_external(_wiggle);
+    jerry_object_set_sz(context, "wiggle", wiggle);
+    jerry_object_set_native_ptr(wiggle, &freeCb, _expcontent(object));
+    jerry_value_free(wiggle);
 
-        auto temporalWiggle = jerry_function_external(_temporalWiggle);
-        jerry_object_set_sz(context, "temporalWiggle", temporalWiggle);
-        jerry_object_set_native_ptr(temporalWiggle, &freeCb, data);
-        jerry_value_free(temporalWiggle);
+    auto temporalWiggle = jerry_function_external(_temporalWiggle);
+    jerry_object_set_sz(context, "temporalWiggle", temporalWiggle);
+    jerry_object_set_native_ptr(temporalWiggle, &freeCb, _expcontent(object));
+    jerry_value_free(temporalWiggle);
 
-        auto propertyGroup = jerry_function_external(_propertyGroup);
-        jerry_object_set_native_ptr(propertyGroup, &freeCb, data);
-        jerry_object_set_sz(context, "propertyGroup", propertyGroup);
-        jerry_value_free(propertyGroup);
+    auto propertyGroup = jerry_function_external(_propertyGroup);
+    jerry_object_set_native_ptr(propertyGroup, &freeCb, _expcontent(object));
+    jerry_object_set_sz(context, "propertyGroup", propertyGroup);
+    jerry_value_free(propertyGroup);
 
-        //propertyIndex
-    }
+    //propertyIndex
 
     //smooth(width=.2, samples=5, t=time)
 
@@ -1127,24 +1162,15 @@ static void _buildProperty(float frameNo, jerry_value_t context, LottieExpressio
 
     //name
 
-    {
-        auto data = _expcontent(exp, frameNo, exp->layer, 2);
-
-        //content("name"), #look for the named property from a layer
-        auto content = jerry_function_external(_content);
-        jerry_object_set_sz(context, EXP_CONTENT, content);
-        jerry_object_set_native_ptr(content, &freeCb, data);
-        jerry_value_free(content);
-
-        auto effect = jerry_function_external(_effect);
-        jerry_object_set_sz(context, EXP_EFFECT, effect);
-        jerry_object_set_native_ptr(effect, &freeCb, data);
-        jerry_value_free(effect);
-    }
+    //content("name"), #look for the named property from a layer
+    auto content = jerry_function_external(_content);
+    jerry_object_set_sz(context, EXP_CONTENT, content);
+    jerry_object_set_native_ptr(content, &freeCb, _expcontent(layer));
+    jerry_value_free(content);
 
     auto effect = jerry_function_external(_effect);
     jerry_object_set_sz(context, EXP_EFFECT, effect);
-    jerry_object_set_native_ptr(effect, &freeCb, _expcontent(exp, frameNo, exp->layer));
+    jerry_object_set_native_ptr(effect, &freeCb, _expcontent(layer));
     jerry_value_free(effect);
 
     //expansions per types
@@ -1160,11 +1186,63 @@ static jerry_value_t _comp(const jerry_call_info_t* info, const jerry_value_t ar
 
     if (!layer) return jerry_undefined();
 
-    auto obj = jerry_object();
-    jerry_object_set_native_ptr(obj, nullptr, layer);
-    _buildLayer(obj, data->frameNo, layer, comp, data->exp);
+    return data->exp->script->engine->layer(layer, comp, data->exp, data->frameNo);
+}
 
-    return obj;
+
+static void _buildComp(jerry_value_t context, ExpContent* data)
+{
+    //layer(index) / layer(name) / layer(otherLayer, reIndex)
+    auto layer = jerry_function_external(_layer);
+    jerry_object_set_sz(context, "layer", layer);
+    jerry_object_set_native_ptr(layer, &freeCb, _expcontent(data));
+    jerry_value_free(layer);
+
+    auto numLayers = jerry_number((float)static_cast<LottieLayer*>(data->obj)->children.count);
+    jerry_object_set_sz(context, "numLayers", numLayers);
+    jerry_value_free(numLayers);
+}
+
+
+static void _buildComp(jerry_value_t context, LottieComposition* comp)
+{
+    //marker
+    //marker.key(index)
+    //marker.key(name)
+    //marker.nearestKey(t)
+    //marker.numKeys
+
+    //activeCamera
+
+    auto width = jerry_number(comp->w);
+    jerry_object_set_sz(context, EXP_WIDTH, width);
+    jerry_value_free(width);
+
+    auto height = jerry_number(comp->h);
+    jerry_object_set_sz(context, EXP_HEIGHT, height);
+    jerry_value_free(height);
+
+    auto duration = jerry_number(comp->duration());
+    jerry_object_set_sz(context, "duration", duration);
+    jerry_value_free(duration);
+
+    //ntscDropFrame
+    //displayStartTime
+
+    auto frameDuration = jerry_number(1.0f / comp->frameRate);
+    jerry_object_set_sz(context, "frameDuration", frameDuration);
+    jerry_value_free(frameDuration);
+
+    //shutterAngle
+    //shutterPhase
+    //bgColor
+    //pixelAspect
+
+    if (comp->name) {
+        auto name = jerry_string((jerry_char_t*)comp->name, strlen(comp->name), JERRY_ENCODING_UTF8);
+        jerry_object_set_sz(context, EXP_NAME, name);
+        jerry_value_free(name);
+    }
 }
 
 
@@ -1262,73 +1340,165 @@ static void _buildMath(jerry_value_t context)
 }
 
 
-void LottieExpressions::buildGlobal(float frameNo, LottieExpression* exp)
+ExpScript* LottieExpressions::compile(LottieExpression* exp)
 {
-    tvg::free(static_cast<ExpContent*>(jerry_object_get_native_ptr(comp, &freeCb)));
-    jerry_object_set_native_ptr(comp, &freeCb, _expcontent(exp, frameNo, exp->layer));
+    //the code is wrapped in a function, the context values and the writables are given as the parameters
+    static const char head[] = "(function(thisProperty,thisLayer,thisComp,comp,index";
+    static const char body[] = "){\n";
+    static const char tail[] = "\nreturn typeof $bm_rt === 'undefined' ? undefined : $bm_rt;})";
 
-    auto index = jerry_number(exp->layer->ix);
-    jerry_object_set_sz(global, EXP_INDEX, index);
-    jerry_value_free(index);
-}
+    uint32_t members = 0;
 
+    auto len = strlen(exp->code);
+    auto size = sizeof(head) + sizeof(body) + len + sizeof(tail);
+    for (uint32_t i = 0; i < EXP_MEMBER_CNT; ++i) {
+        if (!strstr(exp->code, EXP_MEMBERS[i])) continue;
+        members |= (1 << i);
+        size += strlen(EXP_MEMBERS[i]) + 1;
+    }
+    ARRAY_FOREACH(w, exp->writables) size += strlen(w->var) + 1;
 
-void LottieExpressions::buildComp(jerry_value_t context, float frameNo, LottieLayer* comp, LottieExpression* exp)
-{
-    //layer(index) / layer(name) / layer(otherLayer, reIndex)
-    auto layer = jerry_function_external(_layer);
-    jerry_object_set_sz(context, "layer", layer);
+    auto code = tvg::malloc<char*>(size);
+    auto p = code;
+    auto append = [&](const char* str, size_t len) {
+        memcpy(p, str, len);
+        p += len;
+    };
+    append(head, sizeof(head) - 1);
+    for (uint32_t i = 0; i < EXP_MEMBER_CNT; ++i) {
+        if (!(members & (1 << i))) continue;
+        append(",", 1);
+        append(EXP_MEMBERS[i], strlen(EXP_MEMBERS[i]));
+    }
+    ARRAY_FOREACH(w, exp->writables) {
+        append(",", 1);
+        append(w->var, strlen(w->var));
+    }
+    append(body, sizeof(body) - 1);
+    append(exp->code, len);
+    append(tail, sizeof(tail) - 1);
 
-    jerry_object_set_native_ptr(layer, &freeCb, _expcontent(exp, frameNo, comp));
-    jerry_value_free(layer);
+    auto parsed = jerry_parse((jerry_char_t*)code, p - code, JERRY_PARSE_NO_OPTS);
+    tvg::free(code);
 
-    auto numLayers = jerry_number((float)comp->children.count);
-    jerry_object_set_sz(context, "numLayers", numLayers);
-    jerry_value_free(numLayers);
+    if (jerry_value_is_exception(parsed)) {
+        jerry_value_free(parsed);
+        return nullptr;
+    }
+    auto compiled = jerry_run(parsed);
+    jerry_value_free(parsed);
+
+    if (jerry_value_is_exception(compiled)) {
+        jerry_value_free(compiled);
+        return nullptr;
+    }
+
+    auto script = tvg::malloc<ExpScript*>(sizeof(ExpScript));
+    script->code = compiled;
+    script->members = members;
+    script->writableCnt = exp->writables.count;
+    script->exp = exp;
+    script->engine = this;
+    script->result = jerry_undefined();
+    script->tick = 0;
+    script->scope = scope(exp);
+    script->object = _expcontent(exp, 0.0f, exp->object);
+
+    //this property
+    script->property = jerry_object();
+    jerry_object_set_native_ptr(script->property, nullptr, exp->property);
+    _buildProperty(script->property, script->scope->contents[0], script->object);
+
+    return script;
 }
 
 
-void LottieExpressions::buildComp(LottieComposition* comp, float frameNo, LottieExpression* exp)
+ExpScope* LottieExpressions::scope(LottieExpression* exp)
 {
-    buildComp(this->comp, frameNo, comp->root, exp);
+    ARRAY_FOREACH(p, scopes) {
+        if ((*p)->layer == exp->layer) {
+            ++(*p)->refCnt;
+            for (int i = 0; i < 3; ++i) (*p)->contents[i]->exp = exp;
+            return *p;
+        }
+    }
 
-    //marker
-    //marker.key(index)
-    //marker.key(name)
-    //marker.nearestKey(t)
-    //marker.numKeys
+    auto scope = tvg::malloc<ExpScope*>(sizeof(ExpScope));
+    scope->layer = exp->layer;
+    scope->refCnt = 1;
 
-    //activeCamera
+    auto layer = scope->contents[0] = _expcontent(exp, 0.0f, exp->layer);
+    auto comp = scope->contents[1] = _expcontent(exp, 0.0f, exp->layer->comp);
+    auto root = scope->contents[2] = _expcontent(exp, 0.0f, exp->comp->root);
 
-    auto width = jerry_number(comp->w);
-    jerry_object_set_sz(thisComp, EXP_WIDTH, width);
-    jerry_value_free(width);
+    //this layer
+    scope->self = jerry_object();
+    jerry_object_set_native_ptr(scope->self, nullptr, exp->layer);
+    _buildLayer(scope->self, layer, exp->comp->root);
 
-    auto height = jerry_number(comp->h);
-    jerry_object_set_sz(thisComp, EXP_HEIGHT, height);
-    jerry_value_free(height);
+    //this composition
+    scope->comp = jerry_object();
+    _buildComp(scope->comp, comp);
+    _buildComp(scope->comp, exp->comp);
 
-    auto duration = jerry_number(comp->duration());
-    jerry_object_set_sz(thisComp, "duration", duration);
-    jerry_value_free(duration);
+    //main composition
+    scope->main = jerry_function_external(_comp);
+    jerry_object_set_native_ptr(scope->main, &freeCb, _expcontent(root));
+    _buildComp(scope->main, root);
 
-    //ntscDropFrame
-    //displayStartTime
+    scopes.push(scope);
 
-    auto frameDuration = jerry_number(1.0f / comp->frameRate);
-    jerry_object_set_sz(thisComp, "frameDuration", frameDuration);
-    jerry_value_free(frameDuration);
+    return scope;
+}
 
-    //shutterAngle
-    //shutterPhase
-    //bgColor
-    //pixelAspect
 
-    if (comp->name) {
-        auto name = jerry_string((jerry_char_t*)comp->name, strlen(comp->name), JERRY_ENCODING_UTF8);
-        jerry_object_set_sz(thisComp, EXP_NAME, name);
-        jerry_value_free(name);
+void LottieExpressions::discard(ExpScript* script)
+{
+    ARRAY_FOREACH(p, scripts) {
+        if (*p == script) {
+            *p = scripts.last();
+            scripts.pop();
+            break;
+        }
     }
+
+    jerry_value_free(script->code);
+    jerry_value_free(script->property);
+    jerry_value_free(script->result);
+    contentFree(script->object, nullptr);
+
+    auto scope = script->scope;
+    if (--scope->refCnt == 0) {
+        ARRAY_FOREACH(p, scopes) {
+            if (*p == scope) {
+                *p = scopes.last();
+                scopes.pop();
+                break;
+            }
+        }
+        jerry_value_free(scope->self);
+        jerry_value_free(scope->comp);
+        jerry_value_free(scope->main);
+        for (int i = 0; i < 3; ++i) contentFree(scope->contents[i], nullptr);
+        tvg::free(scope);
+    }
+
+    script->exp->script = nullptr;
+    tvg::free(script);
+}
+
+
+bool LottieExpressions::evict(LottieComposition* comp)
+{
+    //the least recently used one of the same composition, the others might be released on another thread
+    ExpScript* target = nullptr;
+    ARRAY_FOREACH(p, scripts) {
+        if ((*p)->exp->comp != comp || (*p)->exp->disabled) continue;
+        if (!target || (*p)->tick < target->tick) target = *p;
+    }
+    if (!target) return false;
+    discard(target);
+    return true;
 }
 
 
@@ -1336,21 +1506,10 @@ jerry_value_t LottieExpressions::buildGlobal()
 {
     global = jerry_current_realm();
 
-    //comp(name)
-    comp = jerry_function_external(_comp);
-    jerry_object_set_sz(global, "comp", comp);
+    //comp(name), thisComp, thisLayer, thisProperty are bound per expression
 
     //footage(name)
 
-    thisComp = jerry_object();
-    jerry_object_set_sz(global, "thisComp", thisComp);
-
-    thisLayer = jerry_object();
-    jerry_object_set_sz(global, "thisLayer", thisLayer);
-
-    thisProperty = jerry_object();
-    jerry_object_set_sz(global, "thisProperty", thisProperty);
-
     auto fromCompToSurface = jerry_function_external(_fromCompToSurface);
     jerry_object_set_sz(global, "fromCompToSurface", fromCompToSurface);
     jerry_value_free(fromCompToSurface);
@@ -1366,58 +1525,108 @@ jerry_value_t LottieExpressions::buildGlobal()
 }
 
 
-void LottieExpressions::buildWritables(LottieExpression* exp)
-{
-    if (exp->writables.empty()) return;
-    ARRAY_FOREACH(p, exp->writables) {
-        auto writable = jerry_number(p->val);
-        jerry_object_set_sz(global, p->var, writable);
-        jerry_value_free(writable);
-    }
-}
-
-
 jerry_value_t LottieExpressions::evaluate(float frameNo, LottieExpression* exp)
 {
-    if (exp->disabled && exp->writables.empty()) return jerry_undefined();
+    if (exp->disabled && (exp->writables.empty() || !exp->script)) return jerry_undefined();
 
-    buildGlobal(frameNo, exp);
+    //the writables are the parameters of the code
+    if (exp->script && exp->script->writableCnt != exp->writables.count) discard(exp->script);
 
-    //main composition
-    buildComp(exp->comp, frameNo, exp);
+    //parse the code once, only the frame dependent values are updated from now on
+    auto retain = true;
+    if (!exp->script) {
+        //over the cap, make a room or use it just once
+        if (scripts.count >= EXP_SCRIPT_CAP) retain = evict(exp->comp);
+        exp->script = compile(exp);
+        if (!exp->script) {
+            TVGERR("LOTTIE", "Failed to compile the expressions!");
+            exp->disabled = true;
+            return jerry_undefined();
+        }
+        if (retain) scripts.push(exp->script);
+    }
 
-    //this composition
-    buildComp(thisComp, frameNo, exp->layer->comp, exp);
+    auto script = exp->script;
 
-    //update global context values
-    _buildProperty(frameNo, global, exp);
+    //the same property is often sampled several times in a frame
+    if (script->tick == tick && tvg::equal(script->frameNo, frameNo)) {
+        ++results.hit;
+        return jerry_value_copy(script->result);
+    }
+    ++results.miss;
 
-    //this layer
-    jerry_object_set_native_ptr(thisLayer, nullptr, exp->layer);
-    _buildLayer(thisLayer, frameNo, exp->layer, exp->comp->root, exp);
+    //the scope is shared with the other expressions of the layer
+    auto scope = script->scope;
+    for (int i = 0; i < 3; ++i) {
+        scope->contents[i]->exp = exp;
+        scope->contents[i]->frameNo = frameNo;
+    }
+    script->object->frameNo = frameNo;
 
     //this property
-    jerry_object_set_native_ptr(thisProperty, nullptr, exp->property);
-    _buildProperty(frameNo, thisProperty, exp);
+    auto value = _value(frameNo, exp->property);
+    jerry_object_set_sz(script->property, EXP_VALUE, value);
+    jerry_value_free(value);
 
     //expansions per object type
-    if (exp->object->type == LottieObject::Transform) _buildTransform(global, frameNo, static_cast<LottieTransform*>(exp->object));
+    if (exp->object->type == LottieObject::Transform) _buildTransform(script->property, frameNo, static_cast<LottieTransform*>(exp->object));
 
-    //update writable values
-    buildWritables(exp);
+    //this layer
+    _buildTransform(scope->self, frameNo, exp->layer->transform);
+
+    //the context values, the members of thisProperty and the writables
+    args.clear();
+    args.push(script->property);
+    args.push(scope->self);
+    args.push(scope->comp);
+    args.push(scope->main);
+    args.push(jerry_number(exp->layer->ix));
+    for (uint32_t i = 0; i < EXP_MEMBER_CNT; ++i) {
+        if (script->members & (1 << i)) args.push(jerry_object_get_sz(script->property, EXP_MEMBERS[i]));
+    }
+    ARRAY_FOREACH(p, exp->writables) args.push(jerry_number(p->val));
 
     //evaluate the code
-    auto eval = jerry_eval((jerry_char_t *) exp->code, strlen(exp->code), JERRY_PARSE_NO_OPTS);
+    auto eval = jerry_call(script->code, jerry_undefined(), args.data, args.count);
+
+    for (uint32_t i = 4; i < args.count; ++i) jerry_value_free(args[i]);
 
     if (jerry_value_is_exception(eval)) {
         TVGERR("LOTTIE", "Failed to dispatch the expressions!");
+        jerry_value_free(eval);
         exp->disabled = true;
+        if (!retain) discard(script);
         return jerry_undefined();
     }
 
-    jerry_value_free(eval);
+    jerry_value_free(script->result);
+    script->result = eval;
+    script->tick = tick;
+    script->frameNo = frameNo;
+
+    auto ret = jerry_value_copy(script->result);
+    if (!retain) discard(script);
 
-    return jerry_object_get_sz(global, "$bm_rt");
+    return ret;
+}
+
+
+jerry_value_t LottieExpressions::layer(LottieLayer* layer, LottieLayer* comp, LottieExpression* exp, float frameNo)
+{
+    ARRAY_FOREACH(p, wrappers) {
+        if (p->layer == layer && p->comp == comp && tvg::equal(p->frameNo, frameNo)) {
+            ++layers.hit;
+            return jerry_value_copy(p->obj);
+        }
+    }
+    ++layers.miss;
+
+    auto obj = jerry_object();
+    jerry_object_set_native_ptr(obj, nullptr, layer);
+    _buildLayer(obj, _expcontent(exp, frameNo, layer, 0), comp);
+    wrappers.push({layer, comp, frameNo, jerry_value_copy(obj)});
+
+    return obj;
 }
 
 
@@ -1427,24 +1636,37 @@ jerry_value_t LottieExpressions::evaluate(float frameNo, LottieExpression* exp)
 
 LottieExpressions::~LottieExpressions()
 {
-    jerry_value_free(thisProperty);
-    jerry_value_free(thisLayer);
-    jerry_value_free(thisComp);
-    jerry_value_free(comp);
+    if (!context) return;
+
+    activate();
+    ARRAY_FOREACH(p, wrappers) jerry_value_free(p->obj);
     jerry_value_free(global);
     jerry_cleanup();
 }
 
 
-LottieExpressions::LottieExpressions()
+void LottieExpressions::activate()
 {
+    if (context) {
+        current = context;
+        return;
+    }
+    //lazy creation on the first use, jerry_init() allocates the context by jerry_port_context_alloc()
     jerry_init(JERRY_INIT_EMPTY);
+    context = current;
     _buildMath(buildGlobal());
 }
 
 
 void LottieExpressions::update(float curTime)
 {
+    activate();
+
+    //invalidate the caches of the previous frame
+    ++tick;
+    ARRAY_FOREACH(p, wrappers) jerry_value_free(p->obj);
+    wrappers.clear();
+
     //time, #current time in seconds
     auto time = jerry_number(curTime);
     jerry_object_set_sz(global, EXP_TIME, time);
@@ -1452,29 +1674,54 @@ void LottieExpressions::update(float curTime)
 }
 
 
-//FIXME: Threads support
-#include "tvgTaskScheduler.h"
-
 LottieExpressions* LottieExpressions::instance()
 {
-    //FIXME: Threads support
-    if (TaskScheduler::threads() > 1) {
-        TVGLOG("LOTTIE", "Lottie Expressions are not supported with tvg threads");
-        return nullptr;
+    ScopedLock lock(engineKey);
+
+    //the loaders are built on the worker threads concurrently, the contexts are shared over the cap
+    auto cap = TaskScheduler::threads() > 0 ? TaskScheduler::threads() : 1;
+
+    if (engines.count < cap) {
+        engines.push(new LottieExpressions);
+        return engines.last();
     }
 
-    if (!exps) exps = new LottieExpressions;
-    ++engineRefCnt;
-    return exps;
+    auto engine = engines.first();
+    ARRAY_FOREACH(p, engines) {
+        if ((*p)->refCnt < engine->refCnt) engine = *p;
+    }
+    ++engine->refCnt;
+    return engine;
 }
 
 
 void LottieExpressions::retrieve(LottieExpressions* instance)
 {
-    if (--engineRefCnt == 0) {
-        delete(instance);
-        exps = nullptr;
+    ScopedLock lock(engineKey);
+
+    if (--instance->refCnt > 0) return;
+
+    ARRAY_FOREACH(p, engines) {
+        if (*p == instance) {
+            *p = engines.last();
+            engines.pop();
+            break;
+        }
     }
+    delete(instance);
+}
+
+
+void LottieExpressions::release(LottieExpression* exp)
+{
+    auto script = exp->script;
+    if (!script) return;
+
+    //the composition might be released on another thread while the others use the engine
+    auto engine = script->engine;
+    ScopedLock lock(engine->key);
+    engine->activate();
+    engine->discard(script);
 }
 
 
@@ -1490,4 +1737,29 @@ RGB32 LottieExpressions::toColor(jerry_value_t obj)
 }
 
 
+/************************************************************************/
+/* JerryScript Port Implementation                                      */
+/************************************************************************/
+
+size_t jerry_port_context_alloc(size_t context_size)
+{
+    //the rest of the buffer is used as the engine heap
+    auto size = context_size + JERRY_GLOBAL_HEAP_SIZE * 1024;
+    current = tvg::malloc<jerry_context_t*>(size);
+    return size;
+}
+
+
+jerry_context_t* jerry_port_context_get()
+{
+    return current;
+}
+
+
+void jerry_port_context_free()
+{
+    tvg::free(current);
+    current = nullptr;
+}
+
 #endif //THORVG_LOTTIE_EXPRESSIONS_SUPPORT
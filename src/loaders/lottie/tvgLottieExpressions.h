@@ -24,12 +24,15 @@
 #define _TVG_LOTTIE_EXPRESSIONS_H_
 
 #include "tvgCommon.h"
+#include "tvgLock.h"
 #include "tvgLottieData.h"
 
 struct LottieExpression;
 struct LottieComposition;
 struct LottieLayer;
 struct LottieModifier;
+struct ExpScript;
+struct ExpScope;
 
 #ifdef THORVG_LOTTIE_EXPRESSIONS_SUPPORT
 
@@ -125,33 +128,63 @@ public:
         return true;
     }
 
+    //hit counts of the frame-scoped caches
+    struct Stats
+    {
+        uint32_t hit = 0, miss = 0;
+    };
+
     void update(float curTime);
 
-    //singleton (no thread safety)
+    const Stats& resultStats() const { return results; }   //the results of the evaluations
+    const Stats& layerStats() const { return layers; }     //the wrapper objects of the layers
+
+    //the wrapper object of the layer, reused in the same frame
+    jerry_value_t layer(LottieLayer* layer, LottieLayer* comp, LottieExpression* exp, float frameNo);
+
+    //shared by the loaders, lock the key while using it
     static LottieExpressions* instance();
     static void retrieve(LottieExpressions* instance);
+    static void release(LottieExpression* exp);
+
+    Key key;
 
 private:
-    LottieExpressions();
+    LottieExpressions() {}
     ~LottieExpressions();
 
+    void activate();
     jerry_value_t evaluate(float frameNo, LottieExpression* exp);
     jerry_value_t buildGlobal();
-
-    void buildComp(LottieComposition* comp, float frameNo, LottieExpression* exp);
-    void buildComp(jerry_value_t context, float frameNo, LottieLayer* comp, LottieExpression* exp);
-    void buildGlobal(float frameNo, LottieExpression* exp);
-    void buildWritables(LottieExpression* exp);
+    ExpScript* compile(LottieExpression* exp);
+    ExpScope* scope(LottieExpression* exp);
+    void discard(ExpScript* script);
+    bool evict(LottieComposition* comp);
 
     Point toPoint2d(jerry_value_t obj);
     RGB32 toColor(jerry_value_t obj);
 
     //global object, attributes, methods
     jerry_value_t global;
-    jerry_value_t comp;
-    jerry_value_t thisComp;
-    jerry_value_t thisLayer;
-    jerry_value_t thisProperty;
+
+    jerry_context_t* context = nullptr;   //the javascript context, created on the first use
+    uint32_t refCnt = 1;                  //the loaders sharing this engine
+
+    Array<ExpScript*> scripts;            //the retained scripts, up to the cap
+    Array<ExpScope*> scopes;              //the context objects per layer, shared by the scripts
+    Array<jerry_value_t> args;            //the arguments of the evaluating script
+
+    //frame-scoped caches, invalidated on the time update
+    struct Wrapper
+    {
+        LottieLayer* layer;
+        LottieLayer* comp;
+        float frameNo;
+        jerry_value_t obj;
+    };
+    Array<Wrapper> wrappers;
+    uint32_t tick = 0;
+    Stats results, layers;
 };
 
 #else
@@ -165,8 +198,10 @@ struct LottieExpressions
     template<typename Property> bool result(TVG_UNUSED float, TVG_UNUSED RenderPath&, TVG_UNUSED Matrix*, TVG_UNUSED LottieModifier*, TVG_UNUSED LottieExpression*) { return false; }
     bool result(TVG_UNUSED float, TVG_UNUSED TextDocument& doc, TVG_UNUSED LottieExpression*) { return false; }
     void update(TVG_UNUSED float) {}
+    Key key;
     static LottieExpressions* instance() { return nullptr; }
     static void retrieve(TVG_UNUSED LottieExpressions* instance) {}
+    static void release(TVG_UNUSED LottieExpression* exp) {}
 };
 
 #endif //THORVG_LOTTIE_EXPRESSIONS_SUPPORT
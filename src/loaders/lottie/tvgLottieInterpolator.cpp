@@ -113,6 +113,12 @@ float LottieInterpolator::NewtonRaphsonIterate(float aX, float aGuessT)
 }
 
 
+float LottieInterpolator::solve(float t)
+{
+    return _calcBezier(getTForX(t), outTangent.y, inTangent.y);
+}
+
+
 /************************************************************************/
 /* External Class Implementation                                        */
 /************************************************************************/
@@ -120,15 +126,20 @@ float LottieInterpolator::NewtonRaphsonIterate(float aX, float aGuessT)
 float LottieInterpolator::progress(float t)
 {
     if (outTangent.x == outTangent.y && inTangent.x == inTangent.y) return t;
-    return _calcBezier(getTForX(t), outTangent.y, inTangent.y);
+    if (!lookup || t < 0.0f || t > 1.0f) return solve(t);
+
+    auto x = t * float(PROGRESS_TABLE_SIZE);
+    auto i = std::min(int(x), PROGRESS_TABLE_SIZE - 1);
+    return tvg::lerp(progresses[i], progresses[i + 1], x - float(i));
 }
 
 
-void LottieInterpolator::set(const char* key, Point& inTangent, Point& outTangent)
+void LottieInterpolator::set(const char* key, Point& inTangent, Point& outTangent, bool lookup)
 {
     if (key) this->key = duplicate(key);
     this->inTangent = inTangent;
     this->outTangent = outTangent;
+    this->lookup = false;
 
     if (outTangent.x == outTangent.y && inTangent.x == inTangent.y) return;
 
@@ -136,4 +147,18 @@ void LottieInterpolator::set(const char* key, Point& inTangent, Point& outTangen
     for (int i = 0; i < SPLINE_TABLE_SIZE; ++i) {
         samples[i] = _calcBezier(float(i) * SAMPLE_STEP_SIZE, outTangent.x, inTangent.x);
     }
+
+    //tabulate the progress once, the steep curves stay with the solver where the table can't keep the error bound
+    if (!lookup || PROGRESS_TABLE_ERROR <= 0.0f) return;
+
+    for (int i = 0; i <= PROGRESS_TABLE_SIZE; ++i) {
+        progresses[i] = solve(float(i) / float(PROGRESS_TABLE_SIZE));
+    }
+
+    for (int i = 0; i < PROGRESS_TABLE_SIZE; ++i) {
+        auto mid = solve((float(i) + 0.5f) / float(PROGRESS_TABLE_SIZE));
+        if (fabsf(mid - (progresses[i] + progresses[i + 1]) * 0.5f) > PROGRESS_TABLE_ERROR) return;
+    }
+
+    this->lookup = true;
 }
\ No newline at end of file
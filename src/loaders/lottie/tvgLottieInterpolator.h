@@ -24,6 +24,8 @@
 #define _TVG_LOTTIE_INTERPOLATOR_H_
 
 #define SPLINE_TABLE_SIZE 11
+#define PROGRESS_TABLE_SIZE 64        //intervals of the eased progress table
+#define PROGRESS_TABLE_ERROR 0.0002f  //allowed error of the table, the curves beyond it are solved exactly. 0 always solves them exactly
 
 struct LottieInterpolator
 {
@@ -31,11 +33,15 @@ struct LottieInterpolator
     Point outTangent, inTangent;
 
     float progress(float t);
-    void set(const char* key, Point& inTangent, Point& outTangent);
+    void set(const char* key, Point& inTangent, Point& outTangent, bool lookup = true);
 
 private:
     static constexpr float SAMPLE_STEP_SIZE = 1.0f / float(SPLINE_TABLE_SIZE - 1);
     float samples[SPLINE_TABLE_SIZE];
+    float progresses[PROGRESS_TABLE_SIZE + 1];  //eased progress at the evenly spaced t
+    bool lookup;                                //the progresses are within the error bound
+
+    float solve(float t);
 
     float getTForX(float aX);
     float binarySubdivide(float aX, float aA, float aB);
@@ -25,19 +25,87 @@
 #include "tvgLottieModel.h"
 #include "tvgLottieParser.h"
 #include "tvgLottieBuilder.h"
+#include "tvgLottieBinary.h"
+
+#if defined(__linux__)
+    #include <fcntl.h>
+    #include <unistd.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+#endif
 
 /************************************************************************/
 /* Internal Class Implementation                                        */
 /************************************************************************/
 
+#if defined(THORVG_FILE_IO_SUPPORT) && defined(__linux__)
+
+//only the pre-tokenized data is mapped, the json text is modified while parsing
+static bool _map(LottieLoader* loader, const char* path)
+{
+    auto fd = open(path, O_RDONLY);
+    if (fd < 0) return false;
+
+    struct stat info;
+    if (fstat(fd, &info) < 0 || info.st_size < (off_t) sizeof(LottieBinaryHeader) || info.st_size > UINT32_MAX) {
+        close(fd);
+        return false;
+    }
+
+    auto data = (char*)mmap(NULL, (size_t) info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (data == (char*) MAP_FAILED) return false;
+
+    if (!lottieBinary(data, (uint32_t) info.st_size)) {
+        munmap(data, (size_t) info.st_size);
+        return false;
+    }
+
+    loader->content = data;
+    loader->size = (uint32_t) info.st_size;
+    loader->mapped = true;
+
+    return true;
+}
+
+
+static void _unmap(LottieLoader* loader)
+{
+    munmap((void*) loader->content, loader->size);
+    loader->content = nullptr;
+    loader->mapped = false;
+}
+
+#else
+
+static bool _map(TVG_UNUSED LottieLoader* loader, TVG_UNUSED const char* path)
+{
+    return false;
+}
+
+
+static void _unmap(TVG_UNUSED LottieLoader* loader)
+{
+}
+
+#endif
+
 void LottieLoader::run(unsigned tid)
 {
     //update frame
     if (comp) {
         builder->update(comp, frameNo);
+    //the model is already loaded by the other
+    } else if (shared) {
+        {
+            ScopedLock lock(key);
+            comp = shared;
+            shared = nullptr;
+        }
+        builder->build(comp);
     //initial loading
     } else {
-        LottieParser parser(content, dirName, builder->expressions());
+        LottieParser parser(content, dirName, builder->expressions(), size);
         if (!parser.parse()) return;
         {
             ScopedLock lock(key);
@@ -57,7 +125,8 @@ void LottieLoader::run(unsigned tid)
 
 void LottieLoader::release()
 {
-    if (copy) {
+    if (mapped) _unmap(this);
+    else if (copy) {
         tvg::free((char*)content);
         content = nullptr;
     }
@@ -81,7 +150,8 @@ LottieLoader::~LottieLoader()
     release();
 
     //TODO: correct position?
-    delete(comp);
+    if (comp) comp->unref();
+    if (shared) shared->unref();
     delete(builder);
 
     tvg::free(dirName);
@@ -90,6 +160,21 @@ LottieLoader::~LottieLoader()
 
 bool LottieLoader::header()
 {
+    LottieBinaryHeader info;
+    auto binary = lottieBinary(content, size, &info);
+
+    if (binary) {
+        if (info.version != LOTTIE_BINARY_VERSION) {
+            TVGLOG("LOTTIE", "Pre-tokenized data version(%d) is not supported, required(%d)", info.version, LOTTIE_BINARY_VERSION);
+            return false;
+        }
+        //written on a machine of the other byte order
+        if (info.order != LOTTIE_BINARY_BYTE_ORDER) {
+            TVGLOG("LOTTIE", "Pre-tokenized data byte order(0x%04x) is not matched", info.order);
+            return false;
+        }
+    }
+
     //A single thread doesn't need to perform intensive tasks.
     if (TaskScheduler::threads() == 0) {
         LoadModule::read();
@@ -105,6 +190,16 @@ bool LottieLoader::header()
         }
     }
 
+    //The pre-tokenized data has the animation info in its header.
+    if (binary) {
+        if (info.frameRate < FLOAT_EPSILON) return false;
+        frameRate = info.frameRate;
+        w = info.w;
+        h = info.h;
+        segmentEnd = frameCnt = (info.endFrame - info.startFrame);
+        return true;
+    }
+
     //Quickly validate the given Lottie file without parsing in order to get the animation info.
     auto startFrame = 0.0f;
     auto endFrame = 0.0f;
@@ -219,29 +314,49 @@ bool LottieLoader::open(const char* data, uint32_t size, const char* rpath, bool
 bool LottieLoader::open(const char* path)
 {
 #ifdef THORVG_FILE_IO_SUPPORT
-    auto f = fopen(path, "r");
-    if (!f) return false;
+    if (!_map(this, path)) {
+        auto f = fopen(path, "rb");
+        if (!f) return false;
 
-    fseek(f, 0, SEEK_END);
+        fseek(f, 0, SEEK_END);
 
-    size = ftell(f);
-    if (size == 0) {
-        fclose(f);
-        return false;
-    }
+        size = ftell(f);
+        if (size == 0) {
+            fclose(f);
+            return false;
+        }
 
-    auto content = tvg::malloc<char*>(sizeof(char) * size + 1);
-    fseek(f, 0, SEEK_SET);
-    size = fread(content, sizeof(char), size, f);
-    content[size] = '\0';
+        auto content = tvg::malloc<char*>(sizeof(char) * size + 1);
+        fseek(f, 0, SEEK_SET);
+        size = fread(content, sizeof(char), size, f);
+        content[size] = '\0';
 
-    fclose(f);
+        fclose(f);
+
+        this->content = content;
+        this->copy = true;
+    }
 
     this->dirName = tvg::dirname(path);
-    this->content = content;
-    this->copy = true;
 
-    return header();
+    if (header()) return true;
+
+    //The pre-tokenized data is outdated or foreign, fall back to its json origin. ex) "sample.lotb" -> "sample.json"
+    if (lottieBinary(content, size)) {
+        release();
+        tvg::free(dirName);
+        dirName = nullptr;
+
+        auto ext = fileext(path);
+        if (ext == path || !strcmp(ext, "json")) return false;
+        auto name = duplicate(path, ext - path);
+        auto json = concat(name, "json");
+        auto ret = open(json);
+        tvg::free(name);
+        tvg::free(json);
+        return ret;
+    }
+    return false;
 #else
     return false;
 #endif
@@ -270,7 +385,7 @@ bool LottieLoader::read()
     //the loading has been already completed
     if (!LoadModule::read()) return true;
 
-    if (!content || size == 0) return false;
+    if (!shared && (!content || size == 0)) return false;
 
     TaskScheduler::request(this);
 
@@ -292,7 +407,10 @@ bool LottieLoader::override(const char* slots, bool byDefault)
 {
     if (!ready() || comp->slots.count == 0) return false;
 
-    //override slots
+    //the model must not be changed while it's building the current frame
+    if (!byDefault) done();
+
+    //override slots, the ones in the same data are applied together by a single rebuild
     if (slots) {
         //Copy the input data because the JSON parser will encode the data immediately.
         auto temp = byDefault ? slots : duplicate(slots);
@@ -307,19 +425,26 @@ bool LottieLoader::override(const char* slots, bool byDefault)
             auto applied = false;
             ARRAY_FOREACH(p, comp->slots) {
                 if (strcmp((*p)->sid, sid)) continue;
-                if (parser.apply(*p, byDefault)) succeed = applied = true;
+                if (parser.apply(*p, byDefault)) {
+                    builder->invalidate(comp, *p);
+                    succeed = applied = true;
+                }
                 break;
             }
             if (!applied) parser.skip();
             ++idx;
         }
         tvg::free((char*)temp);
-        rebuild = succeed;
+        rebuild |= succeed;
         overridden |= succeed;
-        return rebuild;
+        return succeed;
     //reset slots
     } else if (overridden) {
-        ARRAY_FOREACH(p, comp->slots) (*p)->reset();
+        ARRAY_FOREACH(p, comp->slots) {
+            if (!(*p)->overridden) continue;
+            (*p)->reset();
+            builder->invalidate(comp, *p);
+        }
         overridden = false;
         rebuild = true;
     }
@@ -327,6 +452,26 @@ bool LottieLoader::override(const char* slots, bool byDefault)
 }
 
 
+LoadModule* LottieLoader::share()
+{
+    if (!ready()) return nullptr;
+
+    //each instance has its own composition, only the model data is shared.
+    auto comp = this->comp->duplicate();
+    if (!comp) return nullptr;
+
+    auto loader = new LottieLoader;
+    loader->shared = comp;
+    loader->dirName = duplicate(dirName);
+    loader->w = w;
+    loader->h = h;
+    loader->frameRate = frameRate;
+    loader->segmentEnd = loader->frameCnt = frameCnt;
+
+    return loader;
+}
+
+
 float LottieLoader::shorten(float frameNo)
 {
     //This ensures that the target frame number is reached.
@@ -347,8 +492,6 @@ bool LottieLoader::frame(float no)
 
     builder->offTween();
 
-    if (comp) comp->clear();     //clear synchronously
-
     TaskScheduler::request(this);
 
     return true;
@@ -393,6 +536,12 @@ uint32_t LottieLoader::markersCnt()
 }
 
 
+uint32_t LottieLoader::borrowed()
+{
+    return ready() ? (uint32_t) comp->borrowed : 0;
+}
+
+
 const char* LottieLoader::markers(uint32_t index)
 {
     if (!ready() || index >= comp->markers.count) return nullptr;
@@ -454,8 +603,6 @@ bool LottieLoader::tween(float from, float to, float progress)
 
     builder->onTween(shorten(to), progress);
 
-    if (comp) comp->clear();     //clear synchronously
-
     TaskScheduler::request(this);
 
     return true;
@@ -41,10 +41,12 @@ public:
 
     LottieBuilder* builder;
     LottieComposition* comp = nullptr;
+    LottieComposition* shared = nullptr;  //duplicated over the shared model of the cached one, built on loading
 
     Key key;
     char* dirName = nullptr;            //base resource directory
     bool copy = false;                  //"content" is owned by this loader
+    bool mapped = false;                //"content" is a memory map of the pre-tokenized file
     bool overridden = false;            //overridden properties with slots
     bool rebuild = false;               //require building the lottie scene
 
@@ -57,6 +59,7 @@ public:
     bool read() override;
     Paint* paint() override;
     bool override(const char* slot, bool byDefault = false);
+    LoadModule* share() override;
 
     //Frame Controls
     bool frame(float no) override;
@@ -64,6 +67,7 @@ public:
     float curFrame() override;
     float duration() override;
     void sync() override;
+    bool synced() override { return !rebuild; }
 
     //Marker Supports
     uint32_t markersCnt();
@@ -71,9 +75,10 @@ public:
     bool segment(const char* marker, float& begin, float& end);
     Result segment(float begin, float end) override;
 
-    float shorten(float frameNo);  //Reduce the accuracy for performance
+    float shorten(float frameNo) override;  //Reduce the accuracy for performance
     bool tween(float from, float to, float progress);
     bool assign(const char* layer, uint32_t ix, const char* var, float val);
+    uint32_t borrowed();
 
 private:
     bool ready();
@@ -57,6 +57,518 @@ Point LottieTextFollowPath::split(float dLen, float lenSearched, float& angle)
     return {};
 }
 
+//duplicates the objects of the shared model, the duplicates borrow the property data of the origins
+struct LottieDuplicator
+{
+    Array<LottieObject*> origins;      //the pairs of the duplicated objects, the slots are retargeted by them
+    Array<LottieObject*> duplicates;
+    size_t owned = 0;                  //the size of the duplicated objects
+    size_t shared = 0;                 //the size of the borrowed data
+
+    template<typename T>
+    T* gen()
+    {
+        owned += sizeof(T);
+        return new T;
+    }
+
+    template<typename T>
+    void share(T& dst, const T& src)
+    {
+        shared += dst.share(src);
+    }
+
+    void map(LottieObject* origin, LottieObject* duplicate)
+    {
+        origins.push(origin);
+        duplicates.push(duplicate);
+    }
+
+    LottieObject* find(LottieObject* origin)
+    {
+        for (uint32_t i = 0; i < origins.count; ++i) {
+            if (origins[i] == origin) return duplicates[i];
+        }
+        return nullptr;
+    }
+};
+
+
+static LottieObject* _duplicate(LottieDuplicator& dup, LottieObject* src, LottieLayer* comp = nullptr);
+
+
+static void _duplicate(LottieDuplicator& dup, LottieStroke* dst, LottieStroke* src)
+{
+    dup.share(dst->width, src->width);
+    dst->miterLimit = src->miterLimit;
+    dst->cap = src->cap;
+    dst->join = src->join;
+
+    if (!src->dashattr) return;
+    dst->dashattr = dup.gen<LottieStroke::DashAttr>();
+    dup.share(dst->dashattr->offset, src->dashattr->offset);
+    dst->dashattr->values = new LottieFloat[src->dashattr->size];
+    dst->dashattr->size = dst->dashattr->allocated = src->dashattr->size;
+    for (uint8_t i = 0; i < src->dashattr->size; ++i) {
+        dup.share(dst->dashattr->values[i], src->dashattr->values[i]);
+    }
+}
+
+
+static void _duplicate(LottieDuplicator& dup, LottieGradient* dst, LottieGradient* src)
+{
+    dup.share(dst->start, src->start);
+    dup.share(dst->end, src->end);
+    dup.share(dst->height, src->height);
+    dup.share(dst->angle, src->angle);
+    dup.share(dst->opacity, src->opacity);
+    dup.share(dst->colorStops, src->colorStops);
+    dst->id = src->id;
+    dst->opaque = src->opaque;
+}
+
+
+static LottieTransform* _duplicate(LottieDuplicator& dup, LottieTransform* src)
+{
+    auto dst = dup.gen<LottieTransform>();
+    dup.share(dst->position, src->position);
+    dup.share(dst->rotation, src->rotation);
+    dup.share(dst->scale, src->scale);
+    dup.share(dst->anchor, src->anchor);
+    dup.share(dst->opacity, src->opacity);
+    dup.share(dst->skewAngle, src->skewAngle);
+    dup.share(dst->skewAxis, src->skewAxis);
+    if (src->coords) {
+        dst->coords = dup.gen<LottieTransform::SeparateCoord>();
+        dup.share(dst->coords->x, src->coords->x);
+        dup.share(dst->coords->y, src->coords->y);
+    }
+    if (src->rotationEx) {
+        dst->rotationEx = dup.gen<LottieTransform::RotationEx>();
+        dup.share(dst->rotationEx->x, src->rotationEx->x);
+        dup.share(dst->rotationEx->y, src->rotationEx->y);
+    }
+    return dst;
+}
+
+
+static LottieText* _duplicate(LottieDuplicator& dup, LottieText* src)
+{
+    auto dst = dup.gen<LottieText>();
+    dst->alignOption.grouping = src->alignOption.grouping;
+    dup.share(dst->alignOption.anchor, src->alignOption.anchor);
+    dup.share(dst->doc, src->doc);
+
+    if (src->followPath) {
+        dst->followPath = dup.gen<LottieTextFollowPath>();
+        dup.share(dst->followPath->firstMargin, src->followPath->firstMargin);
+        dst->followPath->maskIdx = src->followPath->maskIdx;
+    }
+
+    ARRAY_FOREACH(p, src->ranges) {
+        auto s = *p;
+        auto d = dup.gen<LottieTextRange>();
+        dup.share(d->style.fillColor, s->style.fillColor);
+        dup.share(d->style.strokeColor, s->style.strokeColor);
+        dup.share(d->style.position, s->style.position);
+        dup.share(d->style.scale, s->style.scale);
+        dup.share(d->style.letterSpacing, s->style.letterSpacing);
+        dup.share(d->style.lineSpacing, s->style.lineSpacing);
+        dup.share(d->style.strokeWidth, s->style.strokeWidth);
+        dup.share(d->style.rotation, s->style.rotation);
+        dup.share(d->style.fillOpacity, s->style.fillOpacity);
+        dup.share(d->style.strokeOpacity, s->style.strokeOpacity);
+        dup.share(d->style.opacity, s->style.opacity);
+        d->style.flags = s->style.flags;
+        dup.share(d->offset, s->offset);
+        dup.share(d->maxEase, s->maxEase);
+        dup.share(d->minEase, s->minEase);
+        dup.share(d->maxAmount, s->maxAmount);
+        dup.share(d->smoothness, s->smoothness);
+        dup.share(d->start, s->start);
+        dup.share(d->end, s->end);
+        //the easing is updated on every factor, each instance has its own.
+        if (s->interpolator) d->interpolator = tvg::malloc<LottieInterpolator*>(sizeof(LottieInterpolator));
+        d->based = s->based;
+        d->shape = s->shape;
+        d->rangeUnit = s->rangeUnit;
+        d->random = s->random;
+        d->expressible = s->expressible;
+        dst->ranges.push(d);
+    }
+    return dst;
+}
+
+
+template<typename T>
+static LottieProperty* _duplicate(LottieDuplicator& dup, LottieProperty* src)
+{
+    auto dst = dup.gen<T>();
+    dup.share(*dst, *static_cast<T*>(src));
+    return dst;
+}
+
+
+static LottieEffect* _duplicate(LottieDuplicator& dup, LottieEffect* src)
+{
+    LottieEffect* dst = nullptr;
+
+    switch (src->type) {
+        case LottieEffect::Custom: {
+            auto s = static_cast<LottieFxCustom*>(src);
+            auto d = dup.gen<LottieFxCustom>();
+            ARRAY_FOREACH(p, s->props) {
+                LottieProperty* prop = nullptr;
+                switch (p->property->type) {
+                    case LottieProperty::Type::Float: prop = _duplicate<LottieFloat>(dup, p->property); break;
+                    case LottieProperty::Type::Color: prop = _duplicate<LottieColor>(dup, p->property); break;
+                    case LottieProperty::Type::Vector: prop = _duplicate<LottieVector>(dup, p->property); break;
+                    case LottieProperty::Type::Integer: prop = _duplicate<LottieInteger>(dup, p->property); break;
+                    default: break;
+                }
+                if (prop) d->props.push({prop, p->nm, p->mn});
+            }
+            dst = d;
+            break;
+        }
+        case LottieEffect::Tint: {
+            auto s = static_cast<LottieFxTint*>(src);
+            auto d = dup.gen<LottieFxTint>();
+            dup.share(d->black, s->black);
+            dup.share(d->white, s->white);
+            dup.share(d->intensity, s->intensity);
+            dst = d;
+            break;
+        }
+        case LottieEffect::Fill: {
+            auto s = static_cast<LottieFxFill*>(src);
+            auto d = dup.gen<LottieFxFill>();
+            dup.share(d->color, s->color);
+            dup.share(d->opacity, s->opacity);
+            dst = d;
+            break;
+        }
+        case LottieEffect::Stroke: {
+            auto s = static_cast<LottieFxStroke*>(src);
+            auto d = dup.gen<LottieFxStroke>();
+            dup.share(d->mask, s->mask);
+            dup.share(d->allMask, s->allMask);
+            dup.share(d->color, s->color);
+            dup.share(d->size, s->size);
+            dup.share(d->opacity, s->opacity);
+            dup.share(d->begin, s->begin);
+            dup.share(d->end, s->end);
+            dst = d;
+            break;
+        }
+        case LottieEffect::Tritone: {
+            auto s = static_cast<LottieFxTritone*>(src);
+            auto d = dup.gen<LottieFxTritone>();
+            dup.share(d->bright, s->bright);
+            dup.share(d->midtone, s->midtone);
+            dup.share(d->dark, s->dark);
+            dup.share(d->blend, s->blend);
+            dst = d;
+            break;
+        }
+        case LottieEffect::DropShadow: {
+            auto s = static_cast<LottieFxDropShadow*>(src);
+            auto d = dup.gen<LottieFxDropShadow>();
+            dup.share(d->color, s->color);
+            dup.share(d->opacity, s->opacity);
+            dup.share(d->angle, s->angle);
+            dup.share(d->distance, s->distance);
+            dup.share(d->blurness, s->blurness);
+            dst = d;
+            break;
+        }
+        case LottieEffect::GaussianBlur: {
+            auto s = static_cast<LottieFxGaussianBlur*>(src);
+            auto d = dup.gen<LottieFxGaussianBlur>();
+            dup.share(d->blurness, s->blurness);
+            dup.share(d->direction, s->direction);
+            dup.share(d->wrap, s->wrap);
+            dst = d;
+            break;
+        }
+    }
+
+    dst->nm = src->nm;
+    dst->mn = src->mn;
+    dst->ix = src->ix;
+    dst->enable = src->enable;
+
+    return dst;
+}
+
+
+static void _duplicate(LottieDuplicator& dup, LottieGroup* dst, LottieGroup* src, LottieLayer* comp)
+{
+    ARRAY_FOREACH(p, src->children) {
+        dst->children.push(_duplicate(dup, *p, comp));
+    }
+    dst->blendMethod = src->blendMethod;
+    dst->reqFragment = src->reqFragment;
+    dst->trimpath = src->trimpath;
+    dst->visible = src->visible;
+    dst->allowMerge = src->allowMerge;
+}
+
+
+static LottieLayer* _duplicate(LottieDuplicator& dup, LottieLayer* src, LottieLayer* comp)
+{
+    auto dst = dup.gen<LottieLayer>();
+
+    //the referenced children are attached by the builder
+    if (!src->rid) _duplicate(dup, dst, src, dst);
+    else {
+        dst->blendMethod = src->blendMethod;
+        dst->reqFragment = src->reqFragment;
+    }
+
+    if (src->name) dst->name = duplicate(src->name);
+    dup.share(dst->timeRemap, src->timeRemap);
+    dst->comp = comp;
+    if (src->transform) {
+        dst->transform = _duplicate(dup, src->transform);
+        dup.map(src->transform, dst->transform);
+    }
+
+    ARRAY_FOREACH(p, src->masks) {
+        auto mask = dup.gen<LottieMask>();
+        dup.share(mask->pathset, (*p)->pathset);
+        dup.share(mask->expand, (*p)->expand);
+        dup.share(mask->opacity, (*p)->opacity);
+        mask->method = (*p)->method;
+        mask->inverse = (*p)->inverse;
+        dst->masks.push(mask);
+    }
+
+    ARRAY_FOREACH(p, src->effects) {
+        dst->effects.push(_duplicate(dup, *p));
+    }
+
+    //the render objects prepared by the parser
+    if (!src->statical.pooler.empty()) {
+        auto shape = Shape::gen();
+        shape->appendRect(0.0f, 0.0f, src->w, src->h);
+        if (src->type == LottieLayer::Solid) {
+            uint8_t r, g, b;
+            src->statical.pooler.first()->fill(&r, &g, &b);
+            shape->fill(r, g, b);
+        }
+        shape->ref();
+        dst->statical.pooler.push(shape);
+    }
+
+    dst->timeStretch = src->timeStretch;
+    dst->w = src->w;
+    dst->h = src->h;
+    dst->inFrame = src->inFrame;
+    dst->outFrame = src->outFrame;
+    dst->startFrame = src->startFrame;
+    dst->rid = src->rid;
+    dst->mix = src->mix;
+    dst->pix = src->pix;
+    dst->ix = src->ix;
+    dst->matteType = src->matteType;
+    dst->type = src->type;
+    dst->autoOrient = src->autoOrient;
+    dst->matteSrc = src->matteSrc;
+
+    return dst;
+}
+
+
+static LottieObject* _duplicate(LottieDuplicator& dup, LottieObject* src, LottieLayer* comp)
+{
+    LottieObject* dst = nullptr;
+
+    switch (src->type) {
+        case LottieObject::Layer: {
+            dst = _duplicate(dup, static_cast<LottieLayer*>(src), comp);
+            break;
+        }
+        case LottieObject::Group: {
+            auto d = dup.gen<LottieGroup>();
+            _duplicate(dup, d, static_cast<LottieGroup*>(src), nullptr);
+            dst = d;
+            break;
+        }
+        case LottieObject::Transform: {
+            dst = _duplicate(dup, static_cast<LottieTransform*>(src));
+            break;
+        }
+        case LottieObject::SolidFill: {
+            auto s = static_cast<LottieSolidFill*>(src);
+            auto d = dup.gen<LottieSolidFill>();
+            dup.share(d->color, s->color);
+            dup.share(d->opacity, s->opacity);
+            d->rule = s->rule;
+            dst = d;
+            break;
+        }
+        case LottieObject::SolidStroke: {
+            auto s = static_cast<LottieSolidStroke*>(src);
+            auto d = dup.gen<LottieSolidStroke>();
+            dup.share(d->color, s->color);
+            dup.share(d->opacity, s->opacity);
+            _duplicate(dup, static_cast<LottieStroke*>(d), static_cast<LottieStroke*>(s));
+            dst = d;
+            break;
+        }
+        case LottieObject::GradientFill: {
+            auto s = static_cast<LottieGradientFill*>(src);
+            auto d = dup.gen<LottieGradientFill>();
+            _duplicate(dup, static_cast<LottieGradient*>(d), static_cast<LottieGradient*>(s));
+            d->rule = s->rule;
+            dst = d;
+            break;
+        }
+        case LottieObject::GradientStroke: {
+            auto s = static_cast<LottieGradientStroke*>(src);
+            auto d = dup.gen<LottieGradientStroke>();
+            _duplicate(dup, static_cast<LottieGradient*>(d), static_cast<LottieGradient*>(s));
+            _duplicate(dup, static_cast<LottieStroke*>(d), static_cast<LottieStroke*>(s));
+            dst = d;
+            break;
+        }
+        case LottieObject::Rect: {
+            auto s = static_cast<LottieRect*>(src);
+            auto d = dup.gen<LottieRect>();
+            dup.share(d->position, s->position);
+            dup.share(d->size, s->size);
+            dup.share(d->radius, s->radius);
+            d->clockwise = s->clockwise;
+            dst = d;
+            break;
+        }
+        case LottieObject::Ellipse: {
+            auto s = static_cast<LottieEllipse*>(src);
+            auto d = dup.gen<LottieEllipse>();
+            dup.share(d->position, s->position);
+            dup.share(d->size, s->size);
+            d->clockwise = s->clockwise;
+            dst = d;
+            break;
+        }
+        case LottieObject::Path: {
+            auto s = static_cast<LottiePath*>(src);
+            auto d = dup.gen<LottiePath>();
+            dup.share(d->pathset, s->pathset);
+            d->clockwise = s->clockwise;
+            dst = d;
+            break;
+        }
+        case LottieObject::Polystar: {
+            auto s = static_cast<LottiePolyStar*>(src);
+            auto d = dup.gen<LottiePolyStar>();
+            dup.share(d->position, s->position);
+            dup.share(d->innerRadius, s->innerRadius);
+            dup.share(d->outerRadius, s->outerRadius);
+            dup.share(d->innerRoundness, s->innerRoundness);
+            dup.share(d->outerRoundness, s->outerRoundness);
+            dup.share(d->rotation, s->rotation);
+            dup.share(d->ptsCnt, s->ptsCnt);
+            d->type = s->type;
+            d->clockwise = s->clockwise;
+            dst = d;
+            break;
+        }
+        case LottieObject::Image: {
+            auto d = dup.gen<LottieImage>();
+            dup.share(d->data, static_cast<LottieImage*>(src)->data);
+            dst = d;
+            break;
+        }
+        case LottieObject::Trimpath: {
+            auto s = static_cast<LottieTrimpath*>(src);
+            auto d = dup.gen<LottieTrimpath>();
+            dup.share(d->start, s->start);
+            dup.share(d->end, s->end);
+            dup.share(d->offset, s->offset);
+            d->type = s->type;
+            dst = d;
+            break;
+        }
+        case LottieObject::Text: {
+            dst = _duplicate(dup, static_cast<LottieText*>(src));
+            break;
+        }
+        case LottieObject::Repeater: {
+            auto s = static_cast<LottieRepeater*>(src);
+            auto d = dup.gen<LottieRepeater>();
+            dup.share(d->copies, s->copies);
+            dup.share(d->offset, s->offset);
+            dup.share(d->position, s->position);
+            dup.share(d->rotation, s->rotation);
+            dup.share(d->scale, s->scale);
+            dup.share(d->anchor, s->anchor);
+            dup.share(d->startOpacity, s->startOpacity);
+            dup.share(d->endOpacity, s->endOpacity);
+            d->inorder = s->inorder;
+            dst = d;
+            break;
+        }
+        case LottieObject::RoundedCorner: {
+            auto d = dup.gen<LottieRoundedCorner>();
+            dup.share(d->radius, static_cast<LottieRoundedCorner*>(src)->radius);
+            dst = d;
+            break;
+        }
+        case LottieObject::OffsetPath: {
+            auto s = static_cast<LottieOffsetPath*>(src);
+            auto d = dup.gen<LottieOffsetPath>();
+            dup.share(d->offset, s->offset);
+            dup.share(d->miterLimit, s->miterLimit);
+            d->join = s->join;
+            dst = d;
+            break;
+        }
+        default: {
+            TVGERR("LOTTIE", "Unsupported object type = %d", (int)src->type);
+            return nullptr;
+        }
+    }
+
+    dst->id = src->id;
+    dst->type = src->type;
+    dst->hidden = src->hidden;
+
+    dup.map(src, dst);
+
+    return dst;
+}
+
+
+static LottieFont* _duplicate(LottieDuplicator& dup, LottieFont* src)
+{
+    auto dst = dup.gen<LottieFont>();
+
+    ARRAY_FOREACH(p, src->chars) {
+        auto glyph = dup.gen<LottieGlyph>();
+        ARRAY_FOREACH(c, (*p)->children) {
+            glyph->children.push(_duplicate(dup, *c));
+        }
+        glyph->width = (*p)->width;
+        glyph->code = duplicate((*p)->code);
+        glyph->size = (*p)->size;
+        glyph->len = (*p)->len;
+        dst->chars.push(glyph);
+    }
+
+    //the font data has been registered by the origin already, the name is enough.
+    if (src->name) dst->name = duplicate(src->name);
+    if (src->family) dst->family = duplicate(src->family);
+    if (src->style) dst->style = duplicate(src->style);
+    dst->dataSize = src->dataSize;
+    dst->ascent = src->ascent;
+    dst->origin = src->origin;
+
+    return dst;
+}
+
+
 /************************************************************************/
 /* External Class Implementation                                        */
 /************************************************************************/
@@ -192,10 +704,9 @@ void LottieSlot::reset()
 {
     if (!overridden) return;
 
-    auto shallow = pairs.count == 1 ? true : false;
-
+    //each pair has its own backup, move it back. the borrowed data must not be freed by a deep copy
     ARRAY_FOREACH(pair, pairs) {
-        pair->obj->override(pair->prop, shallow, true);
+        pair->obj->override(pair->prop, true, true);
         delete(pair->prop);
         pair->prop = nullptr;
     }
@@ -335,7 +846,7 @@ float LottieTextRange::factor(float frameNo, float totalLen, float idx)
         if (minEase > 0.0f) out.x = minEase * 0.01f;
         else out.y = -minEase * 0.01f;
 
-        interpolator->set(nullptr, in, out);
+        interpolator->set(nullptr, in, out, false);
         f = interpolator->progress(f);
     }
     f = tvg::clamp(f, 0.0f, 1.0f);
@@ -355,6 +866,13 @@ void LottieFont::prepare()
 void LottieImage::prepare()
 {
     LottieObject::type = LottieObject::Image;
+}
+
+
+void LottieImage::load()
+{
+    //decoded on the first use, the images never shown cost no pixels
+    if (!pooler.empty()) return;
 
     auto picture = Picture::gen();
 
@@ -564,6 +1082,15 @@ LottieProperty* LottieGroup::property(uint16_t ix)
 }
 
 
+bool LottieGroup::animated()
+{
+    ARRAY_FOREACH(p, children) {
+        if ((*p)->animated()) return true;
+    }
+    return false;
+}
+
+
 void LottieGroup::prepare(LottieObject::Type type)
 {
     LottieObject::type = type;
@@ -732,4 +1259,77 @@ LottieComposition::~LottieComposition()
     ARRAY_FOREACH(p, fonts) delete(*p);
     ARRAY_FOREACH(p, slots) delete(*p);
     ARRAY_FOREACH(p, markers) delete(*p);
+
+    if (origin) origin->unref();
+}
+
+
+void LottieComposition::unref()
+{
+    if (--refCnt == 0) delete(this);
+}
+
+
+//another composition over the same model data, it has its own render objects and slots but borrows the keyframes
+LottieComposition* LottieComposition::duplicate()
+{
+    //the model data of the origin must stay intact
+    auto model = origin ? origin : this;
+    if (model->expressions) return nullptr;
+    ARRAY_FOREACH(p, model->slots) {
+        if ((*p)->overridden) return nullptr;
+    }
+
+    LottieDuplicator dup;
+    auto comp = dup.gen<LottieComposition>();
+
+    comp->root = static_cast<LottieLayer*>(_duplicate(dup, model->root));
+    if (model->version) comp->version = tvg::duplicate(model->version);
+    if (model->name) comp->name = tvg::duplicate(model->name);
+    comp->w = model->w;
+    comp->h = model->h;
+    comp->frameRate = model->frameRate;
+
+    ARRAY_FOREACH(p, model->assets) {
+        auto asset = *p;
+        auto precomp = (asset->type == LottieObject::Layer && static_cast<LottieLayer*>(asset)->comp == model->root) ? comp->root : nullptr;
+        comp->assets.push(_duplicate(dup, asset, precomp));
+    }
+
+    ARRAY_FOREACH(p, model->fonts) {
+        comp->fonts.push(_duplicate(dup, *p));
+    }
+
+    ARRAY_FOREACH(p, model->markers) {
+        auto marker = dup.gen<LottieMarker>();
+        if ((*p)->name) marker->name = tvg::duplicate((*p)->name);
+        marker->time = (*p)->time;
+        marker->duration = (*p)->duration;
+        comp->markers.push(marker);
+    }
+
+    //retarget the slots to the duplicated objects
+    ARRAY_FOREACH(p, model->slots) {
+        auto slot = *p;
+        auto layer = static_cast<LottieLayer*>(dup.find(slot->context.layer));
+        auto parent = dup.find(slot->context.parent);
+        LottieSlot* dst = nullptr;
+        ARRAY_FOREACH(pair, slot->pairs) {
+            auto obj = dup.find(pair->obj);
+            if (!obj) continue;
+            if (dst) dst->pairs.push({obj});
+            else dst = new LottieSlot(layer, parent, tvg::duplicate(slot->sid), obj, slot->type);
+        }
+        if (!dst) continue;
+        dup.owned += sizeof(LottieSlot);
+        comp->slots.push(dst);
+    }
+
+    comp->origin = model;
+    comp->borrowed = dup.shared;
+    ++model->refCnt;
+
+    TVGLOG("LOTTIE", "Composition(%p) duplicated: %zu bytes owned, %zu bytes shared", comp, dup.owned, dup.shared);
+
+    return comp;
 }
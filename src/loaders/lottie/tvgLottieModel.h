@@ -23,6 +23,7 @@
 #ifndef _TVG_LOTTIE_MODEL_H_
 #define _TVG_LOTTIE_MODEL_H_
 
+#include <atomic>
 #include "tvgCommon.h"
 #include "tvgStr.h"
 #include "tvgCompressor.h"
@@ -74,6 +75,18 @@ struct LottieStroke
         return dashattr->offset;
     }
 
+    bool animated()
+    {
+        if (width.animated()) return true;
+        if (dashattr) {
+            if (dashattr->offset.animated()) return true;
+            for (uint8_t i = 0; i < dashattr->size; ++i) {
+                if (dashattr->values[i].animated()) return true;
+            }
+        }
+        return false;
+    }
+
     LottieFloat width = 0.0f;
     DashAttr* dashattr = nullptr;
     float miterLimit = 0;
@@ -239,7 +252,7 @@ struct LottieFxGaussianBlur : LottieEffect
 };
 
 
-struct LottieMask
+struct LottieMask : LottieRenderPooler<tvg::Shape>
 {
     LottiePathSet pathset;
     LottieFloat expand = 0.0f;
@@ -284,6 +297,7 @@ struct LottieObject
 
     virtual bool mergeable() { return false; }
     virtual LottieProperty* property(uint16_t ix) { return nullptr; }
+    virtual bool animated() { return true; }  //any property varies over the frames
 
     unsigned long id = 0;      //unique id by name generated by djb2 encoding
     Type type;
@@ -294,12 +308,14 @@ struct LottieObject
 struct LottieGlyph
 {
     Array<LottieObject*> children;   //glyph shapes.
+    RenderPath outline;              //the glyph shapes in one path, built on the first use
     float width;
     char* code;
     char* family = nullptr;
     char* style = nullptr;
     uint16_t size;
     uint8_t len;
+    bool built = false;
 
     void prepare()
     {
@@ -511,6 +527,11 @@ struct LottieTrimpath : LottieObject
         return nullptr;
     }
 
+    bool animated() override
+    {
+        return start.animated() || end.animated() || offset.animated();
+    }
+
     void segment(float frameNo, float& start, float& end, Tween& tween, LottieExpressions* exps);
 
     LottieFloat start = 0.0f;
@@ -551,6 +572,11 @@ struct LottieRoundedCorner : LottieObject
         return nullptr;
     }
 
+    bool animated() override
+    {
+        return radius.animated();
+    }
+
     LottieFloat radius = 0.0f;
 };
 
@@ -565,7 +591,22 @@ struct LottiePath : LottieShape
         return nullptr;
     }
 
+    bool animated() override
+    {
+        return pathset.animated();
+    }
+
     LottiePathSet pathset;
+
+    //the last modified path, reused while the source, the transform and the modifiers are unchanged
+    struct {
+        RenderPath path;
+        LottieModifierParams params;
+        Matrix transform;
+        float frameNo = -1.0f;
+        bool transformed = false;
+        bool valid = false;
+    } modified;
 };
 
 
@@ -581,6 +622,11 @@ struct LottieRect : LottieShape
         return nullptr;
     }
 
+    bool animated() override
+    {
+        return position.animated() || size.animated() || radius.animated();
+    }
+
     LottieVector position = Point{0.0f, 0.0f};
     LottieScalar size = Point{0.0f, 0.0f};
     LottieFloat radius = 0.0f;       //rounded corner radius
@@ -605,6 +651,11 @@ struct LottiePolyStar : LottieShape
         return nullptr;
     }
 
+    bool animated() override
+    {
+        return position.animated() || innerRadius.animated() || outerRadius.animated() || innerRoundness.animated() || outerRoundness.animated() || rotation.animated() || ptsCnt.animated();
+    }
+
     LottieVector position = Point{0.0f, 0.0f};
     LottieFloat innerRadius = 0.0f;
     LottieFloat outerRadius = 0.0f;
@@ -627,6 +678,11 @@ struct LottieEllipse : LottieShape
         return nullptr;
     }
 
+    bool animated() override
+    {
+        return position.animated() || size.animated();
+    }
+
     LottieVector position = Point{0.0f, 0.0f};
     LottieScalar size = Point{0.0f, 0.0f};
 };
@@ -684,6 +740,14 @@ struct LottieTransform : LottieObject
         return nullptr;
     }
 
+    bool animated() override
+    {
+        if (position.animated() || rotation.animated() || scale.animated() || anchor.animated() || opacity.animated() || skewAngle.animated() || skewAxis.animated()) return true;
+        if (coords && (coords->x.animated() || coords->y.animated())) return true;
+        if (rotationEx && (rotationEx->x.animated() || rotationEx->y.animated())) return true;
+        return false;
+    }
+
     void override(LottieProperty* prop, bool shallow, bool release) override
     {
         switch (prop->type) {
@@ -735,6 +799,11 @@ struct LottieSolid : LottieObject
         if (opacity.ix == ix) return &opacity;
         return nullptr;
     }
+
+    bool animated() override
+    {
+        return color.animated() || opacity.animated();
+    }
 };
 
 
@@ -755,6 +824,11 @@ struct LottieSolidStroke : LottieSolid, LottieStroke
         return LottieSolid::property(ix);
     }
 
+    bool animated() override
+    {
+        return LottieSolid::animated() || LottieStroke::animated();
+    }
+
     void override(LottieProperty* prop, bool shallow, bool release) override
     {
         if (release) color.release();
@@ -815,6 +889,11 @@ struct LottieGradient : LottieObject
         return nullptr;
     }
 
+    bool animated() override
+    {
+        return start.animated() || end.animated() || height.animated() || angle.animated() || opacity.animated() || colorStops.animated();
+    }
+
     void override(LottieProperty* prop, bool shallow, bool release = false) override
     {
         if (release) colorStops.release();
@@ -863,6 +942,11 @@ struct LottieGradientStroke : LottieGradient, LottieStroke
         }
         return LottieGradient::property(ix);
     }
+
+    bool animated() override
+    {
+        return LottieGradient::animated() || LottieStroke::animated();
+    }
 };
 
 
@@ -878,6 +962,7 @@ struct LottieImage : LottieObject, LottieRenderPooler<tvg::Picture>
     }
 
     void prepare();
+    void load();
     void update();
 };
 
@@ -902,6 +987,11 @@ struct LottieRepeater : LottieObject
         return nullptr;
     }
 
+    bool animated() override
+    {
+        return copies.animated() || offset.animated() || position.animated() || rotation.animated() || scale.animated() || anchor.animated() || startOpacity.animated() || endOpacity.animated();
+    }
+
     LottieFloat copies = 0.0f;
     LottieFloat offset = 0.0f;
 
@@ -923,6 +1013,11 @@ struct LottieOffsetPath : LottieObject
         LottieObject::type = LottieObject::OffsetPath;
     }
 
+    bool animated() override
+    {
+        return offset.animated() || miterLimit.animated();
+    }
+
     LottieFloat offset = 0.0f;
     LottieFloat miterLimit = 4.0f;
     StrokeJoin join = StrokeJoin::Miter;
@@ -941,6 +1036,7 @@ struct LottieGroup : LottieObject, LottieRenderPooler<tvg::Shape>
     void prepare(LottieObject::Type type = LottieObject::Group);
     bool mergeable() override { return allowMerge; }
     LottieProperty* property(uint16_t ix) override;
+    bool animated() override;
 
     LottieObject* content(unsigned long id)
     {
@@ -957,6 +1053,7 @@ struct LottieGroup : LottieObject, LottieRenderPooler<tvg::Shape>
     }
 
     Scene* scene = nullptr;
+    LottieRetainedScene retained;
     Array<LottieObject*> children;
     BlendMethod blendMethod = BlendMethod::Normal;
 
@@ -990,6 +1087,8 @@ struct LottieLayer : LottieGroup
     LottieLayer* matteTarget = nullptr;
 
     LottieRenderPooler<tvg::Shape> statical;  //static pooler for solid fill and clipper
+    LottieRetainedScene wrapper;              //intermediate scene for matte + masking or precomp clipping + masking
+    LottieRetainedScene content;              //precomp contents, duplicated from the other instance at the same frame
 
     float timeStretch = 1.0f;
     float w = 0.0f, h = 0.0f;
@@ -1011,6 +1110,9 @@ struct LottieLayer : LottieGroup
     Type type = Null;
     bool autoOrient = false;
     bool matteSrc = false;
+    bool fixed = false;         //the contents are not animated at all, built once and reused
+    bool built = false;         //the fixed contents are built in the retained scene
+    bool isolated = false;      //the top-level layer shares nothing with the others, built concurrently
 
     LottieEffect* effectById(unsigned long id)
     {
@@ -1090,10 +1192,8 @@ struct LottieComposition
 {
     ~LottieComposition();
 
-    void clear()
-    {
-        if (root && root->scene) root->scene->remove();
-    }
+    LottieComposition* duplicate();
+    void unref();
 
     float duration() const
     {
@@ -1143,6 +1243,9 @@ struct LottieComposition
     Array<LottieFont*> fonts;
     Array<LottieSlot*> slots;
     Array<LottieMarker*> markers;
+    LottieComposition* origin = nullptr;  //the model data is borrowed from the origin, kept alive by the references
+    atomic<uint16_t> refCnt{1};           //the owner and the duplicates of this composition
+    size_t borrowed = 0;                  //the size of the model data borrowed from the origin
     bool expressions = false;
     bool initiated = false;
 };
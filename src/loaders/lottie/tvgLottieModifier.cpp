@@ -160,6 +160,7 @@ void LottieOffsetModifier::line(RenderPath& out, PathCommand* inCmds, uint32_t i
 
 bool LottieRoundnessModifier::modifyPath(PathCommand* inCmds, uint32_t inCmdsCnt, Point* inPts, uint32_t inPtsCnt, Matrix* transform, RenderPath& out)
 {
+    out.detach();
     buffer->clear();
 
     auto& path = (next) ? *buffer : out;
@@ -217,6 +218,7 @@ bool LottieRoundnessModifier::modifyPolystar(RenderPath& in, RenderPath& out, fl
 {
     constexpr auto ROUNDED_POLYSTAR_MAGIC_NUMBER = 0.47829f;
 
+    out.detach();
     buffer->clear();
 
     auto& path = (next) ? *buffer : out;
@@ -291,6 +293,7 @@ bool LottieOffsetModifier::modifyPath(PathCommand* inCmds, uint32_t inCmdsCnt, P
 {
     if (next) TVGERR("LOTTIE", "Offset has a next modifier?");
 
+    out.detach();
     out.cmds.reserve(inCmdsCnt * 2);
     out.pts.reserve(inPtsCnt * (join == StrokeJoin::Round ? 4 : 2));
 
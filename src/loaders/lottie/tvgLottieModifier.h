@@ -106,4 +106,35 @@ private:
     void corner(RenderPath& out, Line& line, Line& nextLine, uint32_t movetoIndex, bool nextClose);
 };
 
+
+//the parameters of the modifier chain, the same ones modify the same input into the same output
+struct LottieModifierParams
+{
+    float r = 0.0f;
+    float offset = 0.0f;
+    float miterLimit = 0.0f;
+    StrokeJoin join = StrokeJoin::Round;
+
+    LottieModifierParams() = default;
+
+    LottieModifierParams(LottieModifier* modifier)
+    {
+        for (auto m = modifier; m; m = m->next) {
+            if (m->type == LottieModifier::Roundness) {
+                r = static_cast<LottieRoundnessModifier*>(m)->r;
+            } else {
+                auto o = static_cast<LottieOffsetModifier*>(m);
+                offset = o->offset;
+                miterLimit = o->miterLimit;
+                join = o->join;
+            }
+        }
+    }
+
+    bool operator==(const LottieModifierParams& rhs) const
+    {
+        return r == rhs.r && offset == rhs.offset && miterLimit == rhs.miterLimit && join == rhs.join;
+    }
+};
+
 #endif
\ No newline at end of file
@@ -1615,6 +1615,13 @@ void LottieParser::captureSlots(const char* key)
 
     // TODO: Replace with immediate parsing, once the slot spec is confirmed by the LAC
 
+    //pre-tokenized data keeps the slots text as it is
+    if (token) {
+        if (peekType() == kStringType) slots = getStringCopy();
+        else skip();
+        return;
+    }
+
     auto begin = getPos();
     auto end = getPos();
     auto depth = 1;
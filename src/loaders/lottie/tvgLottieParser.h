@@ -30,7 +30,7 @@
 struct LottieParser : LookaheadParserHandler
 {
 public:
-    LottieParser(const char *str, const char* dirName, bool expressions) : LookaheadParserHandler(str)
+    LottieParser(const char *str, const char* dirName, bool expressions, uint32_t size = 0) : LookaheadParserHandler(str, size)
     {
         this->dirName = dirName;
         this->expressions = expressions;
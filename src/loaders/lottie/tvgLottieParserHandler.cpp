@@ -146,6 +146,13 @@ void LookaheadParserHandler::getNull()
 
 bool LookaheadParserHandler::parseNext()
 {
+    if (token) {
+        if (!nextToken()) {
+            Error();
+            return false;
+        }
+        return true;
+    }
     if (reader.HasParseError() || !reader.IterativeParseNext<PARSE_FLAGS>(iss, *this)) {
         Error();
         return false;
@@ -154,6 +161,56 @@ bool LookaheadParserHandler::parseNext()
 }
 
 
+//replay the next token as the json reader would report it
+bool LookaheadParserHandler::nextToken()
+{
+    //reached the end, the state stays as the json reader does
+    if (token == end) return true;
+
+    auto type = static_cast<LottieToken>(*token++);
+
+    switch (type) {
+        case LottieToken::Null: return Null();
+        case LottieToken::False: return Bool(false);
+        case LottieToken::True: return Bool(true);
+        case LottieToken::StartObject: return StartObject();
+        case LottieToken::EndObject: return EndObject(0);
+        case LottieToken::StartArray: return StartArray();
+        case LottieToken::EndArray: return EndArray(0);
+        case LottieToken::Int: {
+            if (end - token < (ptrdiff_t) sizeof(int32_t)) break;
+            int32_t i;
+            memcpy(&i, token, sizeof(i));
+            token += sizeof(i);
+            return Int(i);
+        }
+        case LottieToken::Float: {
+            if (end - token < (ptrdiff_t) sizeof(float)) break;
+            float f;
+            memcpy(&f, token, sizeof(f));
+            token += sizeof(f);
+            return Double(f);
+        }
+        case LottieToken::String:
+        case LottieToken::Key: {
+            if (end - token < (ptrdiff_t) sizeof(uint32_t)) break;
+            uint32_t len;
+            memcpy(&len, token, sizeof(len));
+            token += sizeof(len);
+            if ((uint32_t)(end - token) <= len || token[len] != '\0') break;
+            auto str = token;
+            token += len + 1;
+            return (type == LottieToken::Key) ? Key(str, len, false) : String(str, len, false);
+        }
+        default: break;
+    }
+
+    //corrupted, nothing more to read
+    token = end;
+    return false;
+}
+
+
 bool LookaheadParserHandler::enterObject()
 {
     if (state == kEnteringObject) {
@@ -47,6 +47,7 @@
 
 #include "rapidjson/document.h"
 #include "tvgCommon.h"
+#include "tvgLottieBinary.h"
 
 
 using namespace rapidjson;
@@ -73,10 +74,15 @@ struct LookaheadParserHandler
     LookaheadParsingState   state = kInit;
     Reader                  reader;
     InsituStringStream      iss;
+    const char*             token = nullptr;   //the token stream in place of the json text
+    const char*             end = nullptr;
 
-    LookaheadParserHandler(const char *str) : iss((char*)str)
+    LookaheadParserHandler(const char *str, uint32_t size = 0) : iss((char*)str)
     {
-        reader.IterativeParseInit();
+        if (lottieBinary(str, size)) {
+            token = str + sizeof(LottieBinaryHeader);
+            end = str + size;
+        } else reader.IterativeParseInit();
     }
 
     bool Null()
@@ -175,7 +181,9 @@ struct LookaheadParserHandler
     {
         TVGERR("LOTTIE", "Invalid JSON: unexpected or misaligned data fields.");
         state = kError;
-        reader.IterativeParseNext<PARSE_FLAGS>(iss, *this);   //something wrong but try advancement.
+        //something wrong but try advancement.
+        if (token) nextToken();
+        else reader.IterativeParseNext<PARSE_FLAGS>(iss, *this);
     }
 
     bool Invalid()
@@ -193,6 +201,7 @@ struct LookaheadParserHandler
     bool getBool();
     void getNull();
     bool parseNext();
+    bool nextToken();
     const char* nextObjectKey();
     void skip();
     void skipOut(int depth);
@@ -140,6 +140,7 @@ struct LottieExpression
     LottieObject* object;
     LottieProperty* property;
     Array<Writable> writables;
+    ExpScript* script = nullptr;   //the compiled code, built on the first evaluation
     bool disabled = false;
 
     struct {
@@ -162,6 +163,7 @@ struct LottieExpression
 
     ~LottieExpression()
     {
+        LottieExpressions::release(this);
         ARRAY_FOREACH(p, writables) {
             tvg::free(p->var);
         }
@@ -191,6 +193,14 @@ struct LottieProperty
     LottieExpression* exp = nullptr;
     Type type;
     uint8_t ix;  //property index
+    /* The keyframe found last time, the search starts from it. The lookups write this on the model,
+       which is safe as long as one property is evaluated by one thread at a time:
+       - Every animation sharing a model (LottieComposition::duplicate()) gets its own property objects,
+         only the keyframes are borrowed. So each copy has its own cursor over the shared frames.
+       - The concurrent layer builds only take the isolated layers, which share no properties.
+       The cursor is a hint only, any value falls back to the binary search. */
+    uint32_t cursor = 0;
+    bool shared = false;  //the data is borrowed from the shared model, not to be freed
 
     LottieProperty(Type type = Type::Invalid) : type(type) {}
     virtual ~LottieProperty() {}
@@ -199,6 +209,12 @@ struct LottieProperty
     virtual uint32_t nearest(float frameNo) = 0;
     virtual float frameNo(int32_t key) = 0;
 
+    //the value varies over the frames by the keyframes or the expression
+    bool animated()
+    {
+        return exp || frameCnt() > 1;
+    }
+
     bool copy(LottieProperty* rhs, bool shallow)
     {
         type = rhs->type;
@@ -261,6 +277,19 @@ uint32_t _bsearch(T* frames, float frameNo)
 }
 
 
+//the frame number mostly stays or advances by a little during the playback, look at the cursor and the next first
+template<typename T>
+uint32_t _bsearch(T* frames, float frameNo, uint32_t& cursor)
+{
+    auto key = cursor;
+    if (key + 1 < frames->count && frameNo >= frames->data[key].no) {
+        if (frameNo < frames->data[key + 1].no) return key;
+        if (key + 2 < frames->count && frameNo < frames->data[key + 2].no) return (cursor = key + 1);
+    }
+    return (cursor = _bsearch(frames, frameNo));
+}
+
+
 template<typename T>
 uint32_t _nearest(T* frames, float frameNo)
 {
@@ -343,8 +372,9 @@ struct LottieGenericProperty : LottieProperty
 
     void release()
     {
-        delete(frames);
+        if (!shared) delete(frames);
         frames = nullptr;
+        shared = false;
         if (exp) {
             delete(exp);
             exp = nullptr;
@@ -396,7 +426,7 @@ struct LottieGenericProperty : LottieProperty
         if (frames->count == 1 || frameNo <= frames->first().no) return frames->first().value;
         if (frameNo >= frames->last().no) return frames->last().value;
 
-        auto frame = frames->data + _bsearch(frames, frameNo);
+        auto frame = frames->data + _bsearch(frames, frameNo, cursor);
         if (tvg::equal(frame->no, frameNo)) return frame->value;
         return frame->interpolate(frame + 1, frameNo);
     }
@@ -411,6 +441,8 @@ struct LottieGenericProperty : LottieProperty
     {
         if (LottieProperty::copy(&rhs, shallow)) return;
 
+        shared = shallow && rhs.shared;
+
         if (rhs.frames) {
             if (shallow) {
                 frames = rhs.frames;
@@ -425,6 +457,17 @@ struct LottieGenericProperty : LottieProperty
         }
     }
 
+    //refer to the data of the other, returns the size of the borrowed data
+    uint32_t share(const MyProperty& rhs)
+    {
+        type = rhs.type;
+        ix = rhs.ix;
+        value = rhs.value;
+        frames = rhs.frames;
+        shared = true;
+        return frames ? frames->count * sizeof(Frame) : 0;
+    }
+
     float angle(float frameNo)
     {
         if (!frames || frames->count == 1) return 0;
@@ -435,7 +478,7 @@ struct LottieGenericProperty : LottieProperty
             return frame->angle(frame + 1, frames->last().no);
         }
 
-        auto frame = frames->data + _bsearch(frames, frameNo);
+        auto frame = frames->data + _bsearch(frames, frameNo, cursor);
         return frame->angle(frame + 1, frameNo);
     }
 
@@ -475,6 +518,13 @@ struct LottiePathSet : LottieProperty
             exp = nullptr;
         }
 
+        if (shared) {
+            value = PathSet();
+            frames = nullptr;
+            shared = false;
+            return;
+        }
+
         tvg::free(value.cmds);
         tvg::free(value.pts);
 
@@ -522,6 +572,23 @@ struct LottiePathSet : LottieProperty
         return (*frames)[frames->count];
     }
 
+    uint32_t share(const LottiePathSet& rhs)
+    {
+        type = rhs.type;
+        ix = rhs.ix;
+        value = rhs.value;
+        frames = rhs.frames;
+        shared = true;
+
+        if (!frames) return (value.ptsCnt * sizeof(Point) + value.cmdsCnt * sizeof(PathCommand));
+
+        auto size = frames->count * sizeof(LottieScalarFrame<PathSet>);
+        ARRAY_FOREACH(p, *frames) {
+            size += p->value.ptsCnt * sizeof(Point) + p->value.cmdsCnt * sizeof(PathCommand);
+        }
+        return size;
+    }
+
     //return false means requiring the interpolation
     bool dispatch(float frameNo, PathSet*& path, LottieScalarFrame<PathSet>*& frame, float& t)
     {
@@ -529,7 +596,7 @@ struct LottiePathSet : LottieProperty
         else if (frames->count == 1 || frameNo <= frames->first().no) path = &frames->first().value;
         else if (frameNo >= frames->last().no) path = &frames->last().value;
         else {
-            frame = frames->data + _bsearch(frames, frameNo);
+            frame = frames->data + _bsearch(frames, frameNo, cursor);
             if (tvg::equal(frame->no, frameNo)) path = &frame->value;
             else if (frame->value.ptsCnt != (frame + 1)->value.ptsCnt) {
                 path = &frame->value;
@@ -623,6 +690,9 @@ struct LottiePathSet : LottieProperty
 
     bool operator()(float frameNo, RenderPath& out, Matrix* transform, LottieExpressions* exps, LottieModifier* modifier = nullptr)
     {
+        //the path data is appended in place, it must not be borrowed one
+        out.detach();
+
         //overriding with expressions
         if (exps && exp) {
             frameNo = _loop(frames, frameNo, exp);
@@ -636,6 +706,7 @@ struct LottiePathSet : LottieProperty
     bool operator()(float frameNo, RenderPath& out, Matrix* transform, Tween& tween, LottieExpressions* exps, LottieModifier* modifier = nullptr)
     {
         if (DEFAULT_COND) return operator()(frameNo, out, transform, exps, modifier);
+        out.detach();
         return tweening(frameNo, out, transform, modifier, tween, exps);
     }
 };
@@ -667,6 +738,13 @@ struct LottieColorStop : LottieProperty
             exp = nullptr;
         }
 
+        if (shared) {
+            value = ColorStop();
+            frames = nullptr;
+            shared = false;
+            return;
+        }
+
         if (value.data) {
             tvg::free(value.data);
             value.data = nullptr;
@@ -718,7 +796,7 @@ struct LottieColorStop : LottieProperty
 
     Result tweening(float frameNo, Fill* fill, Tween& tween, LottieExpressions* exps)
     {
-        auto frame = frames->data + _bsearch(frames, frameNo);
+        auto frame = frames->data + _bsearch(frames, frameNo, cursor);
         if (tvg::equal(frame->no, frameNo)) return fill->colorStops(frame->value.data, count);
 
         //from
@@ -764,7 +842,7 @@ struct LottieColorStop : LottieProperty
 
         if (frameNo >= frames->last().no) return fill->colorStops(frames->last().value.data, count);
 
-        auto frame = frames->data + _bsearch(frames, frameNo);
+        auto frame = frames->data + _bsearch(frames, frameNo, cursor);
         if (tvg::equal(frame->no, frameNo)) return fill->colorStops(frame->value.data, count);
 
         //interpolate
@@ -802,10 +880,14 @@ struct LottieColorStop : LottieProperty
     {
         if (LottieProperty::copy(&rhs, shallow)) return;
 
+        shared = rhs.shared;
+
         if (rhs.frames) {
             if (shallow) {
                 frames = rhs.frames;
                 rhs.frames = nullptr;
+            } else if (shared) {
+                frames = rhs.frames;
             } else {
                 frames = new Array<LottieScalarFrame<ColorStop>>;
                 *frames = *rhs.frames;
@@ -819,6 +901,20 @@ struct LottieColorStop : LottieProperty
         count = rhs.count;
     }
 
+    uint32_t share(const LottieColorStop& rhs)
+    {
+        type = rhs.type;
+        ix = rhs.ix;
+        value = rhs.value;
+        frames = rhs.frames;
+        populated = rhs.populated;
+        count = rhs.count;
+        shared = true;
+
+        auto size = count * sizeof(Fill::ColorStop);
+        return frames ? frames->count * (sizeof(LottieScalarFrame<ColorStop>) + size) : size;
+    }
+
     void prepare() {}
 };
 
@@ -847,6 +943,13 @@ struct LottieTextDoc : LottieProperty
             exp = nullptr;
         }
 
+        if (shared) {
+            value.text = value.name = nullptr;
+            frames = nullptr;
+            shared = false;
+            return;
+        }
+
         if (value.text) {
             tvg::free(value.text);
             value.text = nullptr;
@@ -904,7 +1007,7 @@ struct LottieTextDoc : LottieProperty
         if (frames->count == 1 || frameNo <= frames->first().no) return frames->first().value;
         if (frameNo >= frames->last().no) return frames->last().value;
 
-        auto frame = frames->data + _bsearch(frames, frameNo);
+        auto frame = frames->data + _bsearch(frames, frameNo, cursor);
         return frame->value;
     }
 
@@ -925,10 +1028,14 @@ struct LottieTextDoc : LottieProperty
     {
         if (LottieProperty::copy(&rhs, shallow)) return;
 
+        shared = rhs.shared;
+
         if (rhs.frames) {
             if (shallow) {
                 frames = rhs.frames;
                 rhs.frames = nullptr;
+            } else if (shared) {
+                frames = rhs.frames;
             } else {
                 frames = new Array<LottieScalarFrame<TextDocument>>;
                 *frames = *rhs.frames;
@@ -941,6 +1048,16 @@ struct LottieTextDoc : LottieProperty
         }
     }
 
+    uint32_t share(const LottieTextDoc& rhs)
+    {
+        type = rhs.type;
+        ix = rhs.ix;
+        value = rhs.value;
+        frames = rhs.frames;
+        shared = true;
+        return frames ? frames->count * sizeof(LottieScalarFrame<TextDocument>) : 0;
+    }
+
     void prepare() {}
 };
 
@@ -970,11 +1087,14 @@ struct LottieBitmap : LottieProperty
 
     void release()
     {
-        tvg::free(b64Data);
-        tvg::free(mimeType);
+        if (!shared) {
+            tvg::free(b64Data);
+            tvg::free(mimeType);
+        }
 
         b64Data = nullptr;
         mimeType = nullptr;
+        shared = false;
     }
 
     uint32_t frameCnt() override { return 0; }
@@ -988,11 +1108,13 @@ struct LottieBitmap : LottieProperty
         if (shallow) {
             b64Data = rhs.b64Data;
             mimeType = rhs.mimeType;
+            shared = rhs.shared;
             rhs.b64Data = nullptr;
             rhs.mimeType = nullptr;
         } else {
             //TODO: optimize here by avoiding data copy
             TVGLOG("LOTTIE", "Shallow copy of the image data!");
+            shared = false;
             b64Data = duplicate(rhs.b64Data);
             if (rhs.mimeType) mimeType = duplicate(rhs.mimeType);
         }
@@ -1000,6 +1122,20 @@ struct LottieBitmap : LottieProperty
         width = rhs.width;
         height = rhs.height;
     }
+
+    //the shared data pointer lets the picture loaders share the decoded image as well
+    uint32_t share(const LottieBitmap& rhs)
+    {
+        type = rhs.type;
+        ix = rhs.ix;
+        b64Data = rhs.b64Data;
+        mimeType = rhs.mimeType;
+        size = rhs.size;
+        width = rhs.width;
+        height = rhs.height;
+        shared = true;
+        return size;
+    }
 };
 
 using LottieFloat = LottieGenericProperty<LottieScalarFrame<float>, float, LottieProperty::Type::Float>;
@@ -56,4 +56,17 @@ struct LottieRenderPooler
 };
 
 
+//the scene kept alive across the frames to be updated in place
+struct LottieRetainedScene
+{
+    Scene* scene = nullptr;
+    uint32_t tick = 0;      //the last builder update taking the scene
+
+    ~LottieRetainedScene()
+    {
+        if (scene) scene->unref();
+    }
+};
+
+
 #endif //_TVG_LOTTIE_RENDER_POOLER_H_
\ No newline at end of file
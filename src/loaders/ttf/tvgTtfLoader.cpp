@@ -22,6 +22,7 @@
 
 
 #include "tvgStr.h"
+#include "tvgShape.h"
 #include "tvgTtfLoader.h"
 
 #if defined(_WIN32) && (WINAPI_FAMILY == WINAPI_FAMILY_DESKTOP_APP)
@@ -161,6 +162,9 @@ static void _unmap(TtfLoader* loader)
 #endif //THORVG_FILE_IO_SUPPORT
 
 
+static atomic<uint32_t> _ids{};
+
+
 static uint32_t* _codepoints(const char* text, size_t n)
 {
     uint32_t c;
@@ -196,8 +200,35 @@ static uint32_t* _codepoints(const char* text, size_t n)
 }
 
 
+static void _flush(TtfLoader* loader)
+{
+    auto& glyphs = loader->glyphs;
+    glyphs.lru.free();
+    memset(glyphs.buckets, 0, sizeof(glyphs.buckets));
+    glyphs.count = 0;
+}
+
+
+//drop the least recently used glyph to make a room
+static void _evict(TtfLoader* loader)
+{
+    auto& glyphs = loader->glyphs;
+    auto glyph = glyphs.lru.back();
+    if (!glyph) return;
+
+    auto link = &glyphs.buckets[glyph->code & (TTF_GLYPH_BUCKETS - 1)];
+    while (*link != glyph) link = &(*link)->link;
+    *link = glyph->link;
+
+    delete(glyph);
+    --glyphs.count;
+}
+
+
 void TtfLoader::clear()
 {
+    _flush(this);
+
     if (nomap) {
         if (freeData) tvg::free(reader.data);
         reader.data = nullptr;
@@ -220,6 +251,35 @@ void TtfLoader::clear()
 /* External Class Implementation                                        */
 /************************************************************************/
 
+//the glyph of the codepoint, its outline is decoded on the first use only
+TtfGlyph* TtfLoader::glyph(uint32_t code)
+{
+    auto bucket = &glyphs.buckets[code & (TTF_GLYPH_BUCKETS - 1)];
+
+    for (auto glyph = *bucket; glyph; glyph = glyph->link) {
+        if (glyph->code != code) continue;
+        if (glyph != glyphs.lru.head) {
+            glyphs.lru.remove(glyph);
+            glyphs.lru.front(glyph);
+        }
+        return glyph;
+    }
+
+    if (glyphs.count == TTF_GLYPH_CACHE_SIZE) _evict(this);
+
+    auto glyph = new TtfGlyph;
+    glyph->code = code;
+    glyph->idx = reader.glyph(code, glyph->metrics);
+    glyph->valid = (glyph->idx == INVALID_GLYPH) || reader.convert(glyph->path, glyph->metrics, {0.0f, 0.0f}, {0.0f, 0.0f}, 1U);
+    glyph->link = *bucket;
+    *bucket = glyph;
+    glyphs.lru.front(glyph);
+    ++glyphs.count;
+
+    return glyph;
+}
+
+
 
 float TtfLoader::transform(Paint* paint, FontMetrics& metrics, float fontSize, bool italic)
 {
@@ -252,6 +312,7 @@ bool TtfLoader::open(const char* path)
     if (!_map(this, path)) return false;
 
     name = tvg::filename(path);
+    id = ++_ids;
 
     return reader.header();
 #else
@@ -272,6 +333,8 @@ bool TtfLoader::open(const char* data, uint32_t size, TVG_UNUSED const char* rpa
         freeData = true;
     } else reader.data = (uint8_t*)data;
 
+    id = ++_ids;
+
     return reader.header();
 }
 
@@ -286,8 +349,10 @@ bool TtfLoader::read(Shape* shape, char* text, FontMetrics& out)
     auto code = _codepoints(text, n);
     if (!code) return false;
 
-    //TODO: optimize with the texture-atlas?
-    TtfGlyphMetrics gmetrics;
+    //the glyph cache is shared by all the texts of this font
+    ScopedLock lock(glyphs.key);
+
+    auto& path = SHAPE(shape)->rs.path;
     Point offset = {0.0f, reader.metrics.hhea.ascent};
     Point kerning = {0.0f, 0.0f};
     auto lglyph = INVALID_GLYPH;
@@ -295,15 +360,23 @@ bool TtfLoader::read(Shape* shape, char* text, FontMetrics& out)
 
     size_t idx = 0;
     while (code[idx] && idx < n) {
-        auto rglyph = reader.glyph(code[idx], gmetrics);
-        if (rglyph != INVALID_GLYPH) {
-            if (lglyph != INVALID_GLYPH) reader.kerning(lglyph, rglyph, kerning);
-            if (!reader.convert(shape, gmetrics, offset, kerning, 1U)) break;
-            offset.x += (gmetrics.advanceWidth + kerning.x);
-            lglyph = rglyph;
+        auto glyph = this->glyph(code[idx]);
+        if (glyph->idx != INVALID_GLYPH) {
+            if (lglyph != INVALID_GLYPH) reader.kerning(lglyph, glyph->idx, kerning);
+            if (!glyph->valid) break;
+            //place the outline at the pen position
+            auto shift = offset + kerning;
+            if (!glyph->path.empty()) SHAPE(shape)->rs.glyphs.push({(uint64_t(id) << 32) | glyph->idx, shift, path.cmds.count, path.pts.count});
+            path.cmds.push(glyph->path.cmds);
+            path.pts.grow(glyph->path.pts.count);
+            ARRAY_FOREACH(p, glyph->path.pts) {
+                path.pts.push(*p + shift);
+            }
+            offset.x += (glyph->metrics.advanceWidth + kerning.x);
+            lglyph = glyph->idx;
             //store the first glyph with outline min size for italic transform.
-            if (loadMinw && gmetrics.outline) {
-                out.minw = gmetrics.minw;
+            if (loadMinw && glyph->metrics.outline) {
+                out.minw = glyph->metrics.minw;
                 loadMinw = false;
             }
         }
@@ -25,8 +25,26 @@
 
 #include "tvgLoader.h"
 #include "tvgTaskScheduler.h"
+#include "tvgInlist.h"
+#include "tvgLock.h"
 #include "tvgTtfReader.h"
 
+#define TTF_GLYPH_CACHE_SIZE 256   //the glyph outlines kept per font
+#define TTF_GLYPH_BUCKETS 64       //power of 2
+
+//the outline of a glyph at the origin, appended to the text path with the pen position
+struct TtfGlyph
+{
+    INLIST_ITEM(TtfGlyph);
+
+    RenderPath path;
+    TtfGlyphMetrics metrics;
+    TtfGlyph* link;         //the next glyph in the same bucket
+    uint32_t code;          //unicode codepoint
+    uint32_t idx;           //glyph index, INVALID_GLYPH if the font doesn't have it
+    bool valid;             //false if the outline is broken
+};
+
 
 struct TtfLoader : public FontLoader
 {
@@ -36,9 +54,18 @@ struct TtfLoader : public FontLoader
     TtfReader reader;
     char* text = nullptr;
     Shape* shape = nullptr;
+    uint32_t id = 0;     //unique among the opened fonts, identifies the glyphs to the renderer
     bool nomap = false;
     bool freeData = false;
 
+    //the recently used glyphs, the least recently used one is replaced first
+    struct {
+        Inlist<TtfGlyph> lru;
+        TtfGlyph* buckets[TTF_GLYPH_BUCKETS] = {};
+        uint32_t count = 0;
+        Key key;
+    } glyphs;
+
     TtfLoader();
     ~TtfLoader();
 
@@ -50,6 +77,7 @@ struct TtfLoader : public FontLoader
     float transform(Paint* paint, FontMetrics& metrices, float fontSize, bool italic) override;
     bool read(Shape* shape, char* text, FontMetrics& out) override;
     void clear();
+    TtfGlyph* glyph(uint32_t code);
 };
 
 #endif //_TVG_PNG_LOADER_H_
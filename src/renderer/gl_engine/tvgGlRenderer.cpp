@@ -787,6 +787,13 @@ bool GlRenderer::clear()
 }
 
 
+bool GlRenderer::wait()
+{
+    //the render data are prepared in place, but the drawing might read the paints any time
+    return true;
+}
+
+
 bool GlRenderer::target(void* context, int32_t id, uint32_t w, uint32_t h)
 {
     //assume the context zero is invalid
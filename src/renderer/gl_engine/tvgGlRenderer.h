@@ -79,6 +79,7 @@ public:
     ColorSpace colorSpace() override;
     const RenderSurface* mainSurface() override;
     bool sync() override;
+    bool wait() override;
     bool clear() override;
     bool intersectsShape(RenderData data, const RenderRegion& region) override;
     bool intersectsImage(RenderData data, const RenderRegion& region) override;
@@ -0,0 +1,394 @@
+/*
+ * Copyright (c) 2025 the ThorVG project. All rights reserved.
+
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "tvgSwCommon.h"
+
+#ifdef THORVG_SW_GLYPH_CACHE_SUPPORT
+
+#include "tvgInlist.h"
+
+/* The coverage of a small glyph only depends on its outline, the scale and the sub-pixel position.
+   Each coverage is rasterized once and kept as rle spans, then the text rle is composed of them
+   placed at the pen positions. */
+
+#define SW_GLYPH_CACHE_SIZE 512    //the glyph coverages kept among the renderers
+#define SW_GLYPH_BUCKETS 256       //power of 2
+#define SW_GLYPH_MAX_SIZE 64.0f    //the taller texts in pixels are rasterized as the path
+#define SW_GLYPH_SUBPIXELS 4       //the sub-pixel positions of a glyph per axis
+
+/************************************************************************/
+/* Internal Class Implementation                                        */
+/************************************************************************/
+
+struct SwGlyph
+{
+    INLIST_ITEM(SwGlyph);
+
+    SwGlyph* link = nullptr;      //the next glyph in the same bucket
+    SwRle* rle = nullptr;
+    RenderRegion bbox{};          //the coverage region
+    uint64_t id;
+    float sx, sy;                 //the scale of the outline
+    int32_t ox, oy;               //the glyph origin in the coverage
+    uint8_t fx, fy;               //the sub-pixel offset of the origin
+
+    ~SwGlyph()
+    {
+        rleFree(rle);
+    }
+};
+
+
+static struct {
+    Inlist<SwGlyph> lru;          //the most recently used one first
+    SwGlyph* buckets[SW_GLYPH_BUCKETS] = {};
+    uint32_t count = 0;
+    Key key;
+} _cache;
+
+
+//the glyph placed at the pen position
+struct SwPlacement
+{
+    uint32_t idx;                 //the glyph of the render shape
+    int32_t x, y;                 //the pixel position of the glyph origin
+    uint8_t fx, fy;
+};
+
+
+static uint32_t _hash(uint64_t id, float sx, float sy, uint8_t fx, uint8_t fy)
+{
+    uint32_t a, b;
+    memcpy(&a, &sx, sizeof(a));
+    memcpy(&b, &sy, sizeof(b));
+
+    auto h = uint32_t(id) ^ (uint32_t(id >> 32) * 31);
+    h = h * 31 + a;
+    h = h * 31 + b;
+    h = h * 31 + fx * SW_GLYPH_SUBPIXELS + fy;
+    h ^= (h >> 16);
+    return h & (SW_GLYPH_BUCKETS - 1);
+}
+
+
+static SwGlyph* _find(uint64_t id, float sx, float sy, uint8_t fx, uint8_t fy)
+{
+    for (auto glyph = _cache.buckets[_hash(id, sx, sy, fx, fy)]; glyph; glyph = glyph->link) {
+        if (glyph->id != id || glyph->sx != sx || glyph->sy != sy || glyph->fx != fx || glyph->fy != fy) continue;
+        if (glyph != _cache.lru.head) {
+            _cache.lru.remove(glyph);
+            _cache.lru.front(glyph);
+        }
+        return glyph;
+    }
+    return nullptr;
+}
+
+
+static void _evict()
+{
+    auto glyph = _cache.lru.back();
+    if (!glyph) return;
+
+    auto link = &_cache.buckets[_hash(glyph->id, glyph->sx, glyph->sy, glyph->fx, glyph->fy)];
+    while (*link != glyph) link = &(*link)->link;
+    *link = glyph->link;
+
+    delete(glyph);
+    --_cache.count;
+}
+
+
+static void _insert(SwGlyph* glyph)
+{
+    if (_cache.count == SW_GLYPH_CACHE_SIZE) _evict();
+
+    auto bucket = &_cache.buckets[_hash(glyph->id, glyph->sx, glyph->sy, glyph->fx, glyph->fy)];
+    glyph->link = *bucket;
+    *bucket = glyph;
+    _cache.lru.front(glyph);
+    ++_cache.count;
+}
+
+
+//rasterize the glyph outline at its sub-pixel offset, the coverage is relative to the origin
+static SwGlyph* _rasterize(const RenderShape* rshape, const SwPlacement& place, const Matrix& transform, SwMpool* mpool, unsigned tid)
+{
+    auto& glyphs = rshape->glyphs;
+    auto& path = rshape->path;
+    auto& g = glyphs[place.idx];
+    auto last = (place.idx + 1 == glyphs.count);
+    auto cmdCnt = (last ? path.cmds.count : glyphs[place.idx + 1].cmds) - g.cmds;
+    auto ptsEnd = last ? path.pts.count : glyphs[place.idx + 1].pts;
+
+    //keep the coverage in the positive area
+    Point min = {0.0f, 0.0f};
+    for (auto i = g.pts; i < ptsEnd; ++i) {
+        auto pt = path.pts[i] - g.origin;
+        min.x = std::min(min.x, pt.x * transform.e11);
+        min.y = std::min(min.y, pt.y * transform.e22);
+    }
+
+    auto glyph = new SwGlyph;
+    glyph->id = g.id;
+    glyph->sx = transform.e11;
+    glyph->sy = transform.e22;
+    glyph->fx = place.fx;
+    glyph->fy = place.fy;
+    glyph->ox = int32_t(ceilf(-min.x)) + 1;
+    glyph->oy = int32_t(ceilf(-min.y)) + 1;
+
+    auto ox = float(glyph->ox) + float(place.fx) / SW_GLYPH_SUBPIXELS;
+    auto oy = float(glyph->oy) + float(place.fy) / SW_GLYPH_SUBPIXELS;
+    Matrix m = {transform.e11, 0.0f, ox - transform.e11 * g.origin.x, 0.0f, transform.e22, oy - transform.e22 * g.origin.y, 0.0f, 0.0f, 1.0f};
+
+    auto outline = shapeGenOutline(rshape, g.cmds, cmdCnt, g.pts, m, mpool, tid);
+    RenderRegion limit = {{0, 0}, {INT16_MAX, INT16_MAX}};
+    auto ret = true;
+
+    //an empty glyph has no coverage
+    if (mathUpdateOutlineBBox(outline, limit, glyph->bbox, false)) {
+        if (!(glyph->rle = rleRender(nullptr, outline, glyph->bbox, true))) ret = false;
+    }
+
+    mpoolRetOutline(mpool, tid);
+
+    if (!ret) {
+        delete(glyph);
+        return nullptr;
+    }
+    return glyph;
+}
+
+
+//append the glyph coverage at the pen position, the composed rle can't be clipped by the viewport
+static bool _place(Array<SwSpan>& spans, const SwGlyph* glyph, const SwPlacement& place, const RenderRegion& clipBox, RenderRegion& box)
+{
+    if (!glyph->rle || glyph->rle->invalid()) return true;
+
+    auto dx = place.x - glyph->ox;
+    auto dy = place.y - glyph->oy;
+    RenderRegion bbox = {{glyph->bbox.min.x + dx, glyph->bbox.min.y + dy}, {glyph->bbox.max.x + dx, glyph->bbox.max.y + dy}};
+    if (bbox.min.x < clipBox.min.x || bbox.min.y < clipBox.min.y || bbox.max.x > clipBox.max.x || bbox.max.y > clipBox.max.y) return false;
+
+    if (box.valid()) box.add(bbox);
+    else box = bbox;
+
+    spans.grow(glyph->rle->spans.count);
+    ARRAY_FOREACH(p, glyph->rle->spans) {
+        spans.push({uint16_t(p->x + dx), uint16_t(p->y + dy), p->len, p->coverage});
+    }
+    return true;
+}
+
+
+//the neighboring glyphs might share the edge pixels, accumulate the coverages of them
+static void _merge(SwRle* rle)
+{
+    auto& spans = rle->spans;
+
+    std::sort(spans.begin(), spans.end(), [](const SwSpan& a, const SwSpan& b) {
+        return a.y < b.y || (a.y == b.y && a.x < b.x);
+    });
+
+    auto overlapped = false;
+    for (uint32_t i = 1; i < spans.count; ++i) {
+        if (spans[i].y == spans[i - 1].y && spans[i].x < spans[i - 1].x + spans[i - 1].len) {
+            overlapped = true;
+            break;
+        }
+    }
+    if (!overlapped) return;
+
+    Array<SwSpan> merged;
+    merged.reserve(spans.count);
+    Array<uint16_t> cover;
+
+    uint32_t begin = 0;
+    while (begin < spans.count) {
+        //the spans of a row
+        auto y = spans[begin].y;
+        auto end = begin + 1;
+        int32_t right = spans[begin].x + spans[begin].len;
+        auto overlap = false;
+        while (end < spans.count && spans[end].y == y) {
+            if (spans[end].x < right) overlap = true;
+            right = std::max(right, int32_t(spans[end].x + spans[end].len));
+            ++end;
+        }
+
+        if (!overlap) {
+            for (auto i = begin; i < end; ++i) merged.push(spans[i]);
+            begin = end;
+            continue;
+        }
+
+        int32_t left = spans[begin].x;
+        cover.clear();
+        cover.grow(right - left);
+        cover.count = right - left;
+        memset(cover.data, 0, sizeof(uint16_t) * cover.count);
+
+        for (auto i = begin; i < end; ++i) {
+            auto c = cover.data + (spans[i].x - left);
+            for (auto x = 0; x < spans[i].len; ++x) c[x] += spans[i].coverage;
+        }
+
+        //runs of the same coverage
+        int32_t x = 0;
+        while (x < int32_t(cover.count)) {
+            auto c = std::min(cover[x], uint16_t(255));
+            auto run = x + 1;
+            while (run < int32_t(cover.count) && std::min(cover[run], uint16_t(255)) == c) ++run;
+            if (c > 0) merged.push({uint16_t(left + x), y, uint16_t(run - x), uint8_t(c)});
+            x = run;
+        }
+        begin = end;
+    }
+    spans.reset();
+    merged.move(spans);
+}
+
+
+/************************************************************************/
+/* External Class Implementation                                        */
+/************************************************************************/
+
+bool glyphGenRle(SwShape* shape, const RenderShape* rshape, const Matrix& transform, const RenderRegion& clipBox, RenderRegion& renderBox, SwMpool* mpool, unsigned tid)
+{
+    auto& glyphs = rshape->glyphs;
+    auto& path = rshape->path;
+
+    //scaled and translated only
+    if (transform.e12 != 0.0f || transform.e21 != 0.0f || transform.e31 != 0.0f || transform.e32 != 0.0f || transform.e33 != 1.0f) return false;
+    if (tvg::zero(transform.e11) || tvg::zero(transform.e22)) return false;
+    if (glyphs.last().cmds >= path.cmds.count || glyphs.last().pts >= path.pts.count) return false;
+
+    //small texts only, the larger ones are not worth keeping the coverages
+    auto top = path.pts.first().y;
+    auto bottom = top;
+    ARRAY_FOREACH(p, path.pts) {
+        top = std::min(top, p->y);
+        bottom = std::max(bottom, p->y);
+    }
+    if ((bottom - top) * fabsf(transform.e22) > SW_GLYPH_MAX_SIZE) return false;
+
+    //the pixel and the sub-pixel positions of the glyphs
+    Array<SwPlacement> places;
+    places.reserve(glyphs.count);
+    for (uint32_t i = 0; i < glyphs.count; ++i) {
+        auto origin = glyphs[i].origin * transform;
+        auto x = floorf(origin.x);
+        auto y = floorf(origin.y);
+        auto fx = int32_t(roundf((origin.x - x) * SW_GLYPH_SUBPIXELS));
+        auto fy = int32_t(roundf((origin.y - y) * SW_GLYPH_SUBPIXELS));
+        if (fx == SW_GLYPH_SUBPIXELS) {
+            fx = 0;
+            x += 1.0f;
+        }
+        if (fy == SW_GLYPH_SUBPIXELS) {
+            fy = 0;
+            y += 1.0f;
+        }
+        places.push({i, int32_t(x), int32_t(y), uint8_t(fx), uint8_t(fy)});
+    }
+
+    if (!shape->rle) shape->rle = new SwRle;
+    auto& spans = shape->rle->spans;
+    spans.clear();
+
+    RenderRegion box{};
+    Array<SwPlacement*> misses;
+    auto ret = true;
+
+    //compose the cached ones
+    {
+        ScopedLock lock(_cache.key);
+        ARRAY_FOREACH(p, places) {
+            auto glyph = _find(glyphs[p->idx].id, transform.e11, transform.e22, p->fx, p->fy);
+            if (!glyph) misses.push(p);
+            else if (!_place(spans, glyph, *p, clipBox, box)) {
+                ret = false;
+                break;
+            }
+        }
+    }
+
+    //rasterize the new ones out of the lock, then share them
+    Array<SwGlyph*> news;
+    if (ret) {
+        ARRAY_FOREACH(p, misses) {
+            auto& place = **p;
+            SwGlyph* glyph = nullptr;
+            ARRAY_FOREACH(n, news) {
+                auto g = *n;
+                if (g->id == glyphs[place.idx].id && g->fx == place.fx && g->fy == place.fy) {
+                    glyph = g;
+                    break;
+                }
+            }
+            if (!glyph) {
+                if (!(glyph = _rasterize(rshape, place, transform, mpool, tid))) {
+                    ret = false;
+                    break;
+                }
+                news.push(glyph);
+            }
+            if (!_place(spans, glyph, place, clipBox, box)) {
+                ret = false;
+                break;
+            }
+        }
+    }
+
+    //the others might have cached the same ones in the meantime, their spans are already copied
+    if (!news.empty()) {
+        ScopedLock lock(_cache.key);
+        ARRAY_FOREACH(p, news) {
+            auto glyph = *p;
+            if (_find(glyph->id, glyph->sx, glyph->sy, glyph->fx, glyph->fy)) delete(glyph);
+            else _insert(glyph);
+        }
+    }
+
+    if (!ret || spans.empty()) {
+        spans.clear();
+        return false;
+    }
+
+    _merge(shape->rle);
+
+    shape->fastTrack = false;
+    shape->bbox = renderBox = box;
+    return true;
+}
+
+
+void glyphTerm()
+{
+    ScopedLock lock(_cache.key);
+    _cache.lru.free();
+    memset(_cache.buckets, 0, sizeof(_cache.buckets));
+    _cache.count = 0;
+}
+
+#endif //THORVG_SW_GLYPH_CACHE_SUPPORT
@@ -45,10 +45,10 @@ struct AASpans
    int32_t yEnd;
 };
 
-//Careful! Shared resource, No support threading
-static float dudx, dvdx;
-static float dxdya, dxdyb, dudya, dvdya;
-static float xa, xb, ua, va;
+//Careful! Shared resource, the canvases could be drawn on the separate threads
+static thread_local float dudx, dvdx;
+static thread_local float dxdya, dxdyb, dudya, dvdya;
+static thread_local float xa, xb, ua, va;
 
 
 static inline int32_t _modf(float v)
@@ -36,6 +36,43 @@ static atomic<int32_t> rendererCnt{-1};
 static SwMpool* globalMpool = nullptr;
 static uint32_t threadsCnt = 0;
 
+
+//Conservative bounding box of the transformed points in the device space
+static RenderRegion _bounds(const Point* pts, uint32_t cnt, const Matrix& m, float margin)
+{
+    Point min = {FLT_MAX, FLT_MAX};
+    Point max = {-FLT_MAX, -FLT_MAX};
+
+    for (auto pt = pts; pt < pts + cnt; ++pt) {
+        auto p = *pt * m;
+        if (p.x < min.x) min.x = p.x;
+        if (p.x > max.x) max.x = p.x;
+        if (p.y < min.y) min.y = p.y;
+        if (p.y > max.y) max.y = p.y;
+    }
+
+    //one more pixel for the antialiasing
+    margin += 1.0f;
+
+    return {{int32_t(floorf(min.x - margin)), int32_t(floorf(min.y - margin))}, {int32_t(ceilf(max.x + margin)), int32_t(ceilf(max.y + margin))}};
+}
+
+
+//hash of the path data at the sub-pixel placement
+static uint32_t _key(const void* data, const Matrix& m)
+{
+    auto fx = uint32_t((m.e13 - floorf(m.e13)) * 64.0f);
+    auto fy = uint32_t((m.e23 - floorf(m.e23)) * 64.0f);
+    return uint32_t(uintptr_t(data) >> 4) ^ (fx * 31 + fy);
+}
+
+
+//the region is not touching the clip box, thus no spans were clipped out
+static bool _inside(const RenderRegion& region, const RenderRegion& clipBox)
+{
+    return (region.min.x > clipBox.min.x && region.min.y > clipBox.min.y && region.max.x < clipBox.max.x && region.max.y < clipBox.max.y);
+}
+
 struct SwTask : Task
 {
     SwSurface* surface = nullptr;
@@ -51,8 +88,10 @@ struct SwTask : Task
     bool disposed : 1;                //Disposed task?
     bool nodirty : 1;                 //target for partial rendering?
     bool valid : 1;
+    bool culled : 1;                  //skipped out of the viewport, flags are kept until it gets visible.
+    bool leading : 1;                 //its outcome could be referred by the instances
 
-    SwTask() : pushed(false), disposed(false) {}
+    SwTask() : pushed(false), disposed(false), culled(false), leading(false) {}
 
     const RenderRegion& bounds()
     {
@@ -68,6 +107,7 @@ struct SwTask : Task
 
     virtual void dispose() = 0;
     virtual bool clip(SwRle* target) = 0;
+    virtual bool offscreen() = 0;
     virtual ~SwTask() {}
 };
 
@@ -76,6 +116,9 @@ struct SwShapeTask : SwTask
 {
     SwShape shape;
     const RenderShape* rshape = nullptr;
+    SwShapeTask* leader = nullptr;        //the preceding instance sharing the path data
+    RenderRegion strokeBox = {};          //the region of the stroke rle, kept over the color only updates
+    atomic<bool> shareable{false};        //the fill rle is ready to be reused by the instances
     bool clipper = false;
 
     /* We assume that if the stroke width is greater than 2,
@@ -100,6 +143,71 @@ struct SwShapeTask : SwTask
         return (width * sqrt(transform.e11 * transform.e11 + transform.e12 * transform.e12));
     }
 
+    bool offscreen() override
+    {
+        //clippers must be prepared always for their targets
+        if (clipper || rshape->path.pts.empty()) return false;
+
+        //stroke outline may grow up to the miter spike
+        auto margin = 0.0f;
+        if (rshape->stroke && rshape->stroke->width > 0.0f) {
+            auto scale = sqrtf(transform.e11 * transform.e11 + transform.e12 * transform.e12 + transform.e21 * transform.e21 + transform.e22 * transform.e22);
+            margin = rshape->stroke->width * scale * std::max(rshape->stroke->miterlimit, 2.0f) * 0.5f;
+        }
+
+        return !_bounds(rshape->path.pts.data, rshape->path.pts.count, transform, margin).intersected(curBox);
+    }
+
+    //the fill rle solely depends on the path and the transform
+    bool instantiable(float strokeWidth)
+    {
+        return !clipper && clips.empty() && strokeWidth == 0.0f && !rshape->trimpath();
+    }
+
+    //the same path placed at the integer offset of this?
+    bool placed(const RenderShape* rshape, const Matrix& m)
+    {
+        if (this->rshape->path.pts.data != rshape->path.pts.data || this->rshape->path.pts.count != rshape->path.pts.count || this->rshape->rule != rshape->rule) return false;
+
+        auto& t = transform;
+        if (m.e11 != t.e11 || m.e12 != t.e12 || m.e21 != t.e21 || m.e22 != t.e22) return false;
+        if (m.e31 != t.e31 || m.e32 != t.e32 || m.e33 != t.e33) return false;
+
+        //a sub-pixel shift changes the coverage
+        auto dx = m.e13 - t.e13;
+        auto dy = m.e23 - t.e23;
+        return (dx == roundf(dx) && dy == roundf(dy));
+    }
+
+    //reuse the fill rle of the leader if this is placed at the integer offset of it
+    bool instance(float strokeWidth, RenderRegion& renderBox)
+    {
+        if (!leader || !leader->shareable || !instantiable(strokeWidth)) return false;
+        if (!leader->placed(rshape, transform)) return false;
+
+        auto ox = int32_t(roundf(transform.e13 - leader->transform.e13));
+        auto oy = int32_t(roundf(transform.e23 - leader->transform.e23));
+        auto& bbox = leader->shape.bbox;
+        RenderRegion box = {{bbox.min.x + ox, bbox.min.y + oy}, {bbox.max.x + ox, bbox.max.y + oy}};
+        if (!_inside(box, curBox)) return false;
+
+        if (leader->shape.fastTrack) shape.fastTrack = true;
+        else shape.rle = rleCopy(shape.rle, leader->shape.rle, ox, oy);
+        shape.bbox = renderBox = box;
+        return true;
+    }
+
+    //compose the fill rle of the small text from the cached glyph coverages, opt-in by the build option
+    bool glyphs(TVG_UNUSED float strokeWidth, TVG_UNUSED RenderRegion& renderBox, TVG_UNUSED unsigned tid)
+    {
+#ifdef THORVG_SW_GLYPH_CACHE_SUPPORT
+        if (rshape->glyphs.empty() || rshape->fill || !instantiable(strokeWidth)) return false;
+        return glyphGenRle(&shape, rshape, transform, curBox, renderBox, mpool, tid);
+#else
+        return false;
+#endif
+    }
+
     bool clip(SwRle* target) override
     {
         if (shape.strokeRle) return rleClip(target, shape.strokeRle);
@@ -124,9 +232,13 @@ struct SwShapeTask : SwTask
         //Shape
         if (updateShape || flags & (RenderUpdateFlag::Color | RenderUpdateFlag::Gradient)) {
             updateFill = (MULTIPLY(rshape->color.a, opacity) || rshape->fill);
-            if (updateShape) shapeReset(&shape);
+            shapeReset(&shape);  //the fill rle is generated again, don't accumulate the spans
             if (updateFill || clipper) {
-                if (shapePrepare(&shape, rshape, transform, curBox, renderBox, mpool, tid, clips.count > 0 ? true : false)) {
+                if (instance(strokeWidth, renderBox)) {
+                    //nothing to do, the leader did it.
+                } else if (glyphs(strokeWidth, renderBox, tid)) {
+                    //composed of the glyphs.
+                } else if (shapePrepare(&shape, rshape, transform, curBox, renderBox, mpool, tid, clips.count > 0 ? true : false)) {
                     if (!shapeGenRle(&shape, rshape, antialiasing(strokeWidth))) goto err;
                 } else {
                     updateFill = false;
@@ -147,6 +259,7 @@ struct SwShapeTask : SwTask
             if (strokeWidth > 0.0f) {
                 shapeResetStroke(&shape, rshape, transform);
                 if (!shapeGenStrokeRle(&shape, rshape, transform, curBox, renderBox, mpool, tid)) goto err;
+                strokeBox = renderBox;
                 if (auto fill = rshape->strokeFill()) {
                     auto ctable = (flags & RenderUpdateFlag::GradientStroke) ? true : false;
                     if (ctable) shapeResetStrokeFill(&shape);
@@ -155,6 +268,10 @@ struct SwShapeTask : SwTask
             } else {
                 shapeDelStroke(&shape);
             }
+        //the stroke rle is not changed, but the fill renews the render region
+        } else if (shape.strokeRle && !shape.strokeRle->invalid()) {
+            if (renderBox.valid()) renderBox.add(strokeBox);
+            else renderBox = strokeBox;
         }
 
         //Clear current task memorypool here if the clippers would use the same memory pool
@@ -168,6 +285,11 @@ struct SwShapeTask : SwTask
             if (!clipShapeRle && !clipStrokeRle) goto err;
         }
 
+        //the instances could take over the fill rle unless it's clipped by the viewport
+        if (leading && updateFill && instantiable(strokeWidth) && _inside(shape.bbox, curBox)) {
+            if (shape.fastTrack || (shape.rle && shape.rle->valid())) shareable = true;
+        }
+
         valid = true;
         curBox = renderBox; //sync
         if (!nodirty) dirtyRegion->add(prvBox, curBox);
@@ -198,6 +320,12 @@ struct SwImageTask : SwTask
         return true;
     }
 
+    bool offscreen() override
+    {
+        Point pts[] = {{0.0f, 0.0f}, {float(source->w), 0.0f}, {float(source->w), float(source->h)}, {0.0f, float(source->h)}};
+        return !_bounds(pts, 4, transform, 0.0f).intersected(curBox);
+    }
+
     void run(unsigned tid) override
     {
         //invisible
@@ -298,19 +426,27 @@ bool SwRenderer::clear()
 bool SwRenderer::sync()
 {
     //clear if the rendering was not triggered.
+    ARRAY_FOREACH(p, tasks) (*p)->done();
+
+    //the instances might refer to the disposed ones until they are done
     ARRAY_FOREACH(p, tasks) {
         if ((*p)->disposed) delete(*p);
-        else {
-            (*p)->done();
-            (*p)->pushed = false;
-        }
+        else (*p)->pushed = (*p)->leading = false;
     }
     tasks.clear();
+    memset(leaders, 0, sizeof(leaders));
 
     return true;
 }
 
 
+bool SwRenderer::wait()
+{
+    ARRAY_FOREACH(p, tasks) (*p)->done();
+    return !tasks.empty();
+}
+
+
 bool SwRenderer::target(pixel_t* data, uint32_t stride, uint32_t w, uint32_t h, ColorSpace cs)
 {
     if (!data || stride == 0 || w == 0 || h == 0 || w > stride) return false;
@@ -837,6 +973,19 @@ void SwRenderer::dispose(RenderData data)
 {
     auto task = static_cast<SwTask*>(data);
     task->done();
+
+    //the instances might be working with its outcome
+    if (task->leading && task->pushed) {
+        ARRAY_FOREACH(p, tasks) (*p)->done();
+    }
+
+    //the shapes prepared later in this frame must not take it as their leader
+    for (auto& leader : leaders) {
+        if (leader != task) continue;
+        static_cast<SwShapeTask*>(task)->shareable = false;
+        leader = nullptr;
+    }
+
     task->dispose();
 
     if (task->pushed) task->disposed = true;
@@ -856,7 +1005,7 @@ void* SwRenderer::prepareCommon(SwTask* task, const Matrix& transform, const Arr
     task->dirtyRegion = &dirtyRegion;
     task->opacity = opacity;
     task->nodirty = dirtyRegion.deactivated();
-    task->flags = flags;
+    task->flags = task->culled ? (task->flags | flags) : flags;
     task->valid = false;
 
     if (!task->pushed) {
@@ -871,7 +1020,11 @@ void* SwRenderer::prepareCommon(SwTask* task, const Matrix& transform, const Arr
         static_cast<SwTask*>(*p)->done();
     }
 
-    if (flags) TaskScheduler::request(task);
+    if (flags) {
+        //Skip preparing the invisible. It will be done with the kept flags once it comes into the viewport.
+        if ((task->culled = task->offscreen())) task->invisible();
+        else TaskScheduler::request(task);
+    }
 
     return task;
 }
@@ -893,13 +1046,32 @@ RenderData SwRenderer::prepare(RenderSurface* surface, RenderData data, const Ma
 RenderData SwRenderer::prepare(const RenderShape& rshape, RenderData data, const Matrix& transform, Array<RenderData>& clips, uint8_t opacity, RenderUpdateFlag flags, bool clipper)
 {
     auto task = static_cast<SwShapeTask*>(data);
-    if (task) task->done();
-    else {
+    if (task) {
+        task->done();
+        //the instances might be working with its outcome
+        if (task->leading && task->pushed) {
+            ARRAY_FOREACH(p, tasks) (*p)->done();
+        }
+    } else {
         task = new SwShapeTask;
         task->rshape = &rshape;
     }
 
     task->clipper = clipper;
+    task->leader = nullptr;
+    if (flags) task->shareable = false;
+
+    //the shapes sharing the path data (duplicates or instances), the first one at each sub-pixel placement leads the rest.
+    if (!clipper && clips.empty() && rshape.path.pts.count > 0) {
+        auto& slot = leaders[_key(rshape.path.pts.data, transform) % (sizeof(leaders) / sizeof(leaders[0]))];
+        auto leader = static_cast<SwShapeTask*>(slot);
+        if (leader && leader != task && leader->placed(&rshape, transform)) {
+            task->leader = leader;
+        } else {
+            slot = task;
+            task->leading = true;
+        }
+    }
 
     return prepareCommon(task, transform, clips, opacity, flags);
 }
@@ -911,6 +1083,9 @@ bool SwRenderer::term()
 
     mpoolTerm(globalMpool);
     globalMpool = nullptr;
+#ifdef THORVG_SW_GLYPH_CACHE_SUPPORT
+    glyphTerm();
+#endif
     rendererCnt = -1;
 
     return true;
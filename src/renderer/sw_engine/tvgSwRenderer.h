@@ -52,6 +52,7 @@ public:
     const RenderSurface* mainSurface() override;
     bool clear() override;
     bool sync() override;
+    bool wait() override;
     bool intersectsShape(RenderData data, const RenderRegion& region) override;
     bool intersectsImage(RenderData data, const RenderRegion& region) override;
     bool target(pixel_t* data, uint32_t stride, uint32_t w, uint32_t h, ColorSpace cs);
@@ -80,6 +81,7 @@ private:
     SwSurface*           surface = nullptr;           //active surface
     Array<SwTask*>       tasks;                       //async task list
     Array<SwSurface*>    compositors;                 //render targets cache list
+    SwTask*              leaders[32] = {};            //the first shape tasks among the ones sharing the path data
     RenderDirtyRegion    dirtyRegion;                 //partial rendering support
     SwMpool*             mpool;                       //private memory pool
     bool                 sharedMpool;                 //memory-pool behavior policy
@@ -862,6 +862,22 @@ SwRle* rleRender(const RenderRegion* bbox)
 }
 
 
+SwRle* rleCopy(SwRle* rle, const SwRle* src, int32_t dx, int32_t dy)
+{
+    if (!rle) rle = new SwRle;
+    rle->spans.clear();
+    rle->spans.reserve(src->spans.count);
+    rle->spans.count = src->spans.count;
+
+    auto dst = rle->spans.data;
+    ARRAY_FOREACH(p, src->spans) {
+        *dst = {uint16_t(p->x + dx), uint16_t(p->y + dy), p->len, p->coverage};
+        ++dst;
+    }
+    return rle;
+}
+
+
 void rleReset(SwRle* rle)
 {
     if (rle) rle->spans.clear();
@@ -359,6 +359,41 @@ static bool _axisAlignedRect(const SwOutline* outline)
 }
 
 
+static void _genOutline(SwOutline& outline, const PathCommand* cmds, uint32_t cmdCnt, const Point* pts, const Matrix& transform)
+{
+    auto closed = false;
+
+    while (cmdCnt-- > 0) {
+        switch (*cmds) {
+            case PathCommand::Close: {
+                if (!closed) closed = _outlineClose(outline);
+                break;
+            }
+            case PathCommand::MoveTo: {
+                closed = _outlineMoveTo(outline, pts, transform, closed);
+                ++pts;
+                break;
+            }
+            case PathCommand::LineTo: {
+                if (closed) closed = _outlineBegin(outline);
+                _outlineLineTo(outline, pts, transform);
+                ++pts;
+                break;
+            }
+            case PathCommand::CubicTo: {
+                if (closed) closed = _outlineBegin(outline);
+                _outlineCubicTo(outline, pts, pts + 1, pts + 2, transform);
+                pts += 3;
+                break;
+            }
+        }
+        ++cmds;
+    }
+
+    if (!closed) _outlineEnd(outline);
+}
+
+
 static SwOutline* _genOutline(SwShape* shape, const RenderShape* rshape, const Matrix& transform, SwMpool* mpool, unsigned tid, bool hasComposite, bool trimmed = false)
 {
     PathCommand *cmds, *trimmedCmds = nullptr;
@@ -387,38 +422,7 @@ static SwOutline* _genOutline(SwShape* shape, const RenderShape* rshape, const M
     if (cmdCnt == 0 || ptsCnt == 0) return nullptr;
 
     auto outline = mpoolReqOutline(mpool, tid);
-    auto closed = false;
-
-    //Generate Outlines
-    while (cmdCnt-- > 0) {
-        switch (*cmds) {
-            case PathCommand::Close: {
-                if (!closed) closed = _outlineClose(*outline);
-                break;
-            }
-            case PathCommand::MoveTo: {
-                closed = _outlineMoveTo(*outline, pts, transform, closed);
-                ++pts;
-                break;
-            }
-            case PathCommand::LineTo: {
-                if (closed) closed = _outlineBegin(*outline);
-                _outlineLineTo(*outline, pts, transform);
-                ++pts;
-                break;
-            }
-            case PathCommand::CubicTo: {
-                if (closed) closed = _outlineBegin(*outline);
-                _outlineCubicTo(*outline, pts, pts + 1, pts + 2, transform);
-                pts += 3;
-                break;
-            }
-        }
-        ++cmds;
-    }
-
-    if (!closed) _outlineEnd(*outline);
-
+    _genOutline(*outline, cmds, cmdCnt, pts, transform);
     outline->fillRule = rshape->rule;
 
     tvg::free(trimmedCmds);
@@ -444,6 +448,18 @@ bool shapePrepare(SwShape* shape, const RenderShape* rshape, const Matrix& trans
 }
 
 
+//the outline of a part of the path, such as a glyph of the text
+SwOutline* shapeGenOutline(const RenderShape* rshape, uint32_t cmds, uint32_t cmdCnt, uint32_t pts, const Matrix& transform, SwMpool* mpool, unsigned tid)
+{
+    if (cmdCnt == 0) return nullptr;
+
+    auto outline = mpoolReqOutline(mpool, tid);
+    _genOutline(*outline, rshape->path.cmds.data + cmds, cmdCnt, rshape->path.pts.data + pts, transform);
+    outline->fillRule = rshape->rule;
+    return outline;
+}
+
+
 bool shapePrepared(const SwShape* shape)
 {
     return shape->rle ? true : false;
@@ -21,8 +21,319 @@
  */
 
 #include "tvgFrameModule.h"
+#include "tvgTaskScheduler.h"
 #include "tvgAnimation.h"
 
+/************************************************************************/
+/* Internal Class Implementation                                        */
+/************************************************************************/
+
+struct FrameBatch
+{
+    uint32_t** buffers;
+    uint32_t stride, w, h;
+    ColorSpace cs;
+    float begin, step;
+};
+
+
+//renders the adjacent frames in a row, the instance could reuse the most of the previous frame
+struct FrameWorker : Task
+{
+    const FrameBatch* batch;
+    SwCanvas* canvas = nullptr;
+    Picture* picture = nullptr;
+    uint32_t first = 0, last = 0;
+    Result result = Result::Success;
+
+    FrameWorker(const FrameBatch* batch) : batch(batch) {}
+
+    ~FrameWorker()
+    {
+        done();
+        delete(canvas);
+    }
+
+    void render()
+    {
+        auto loader = static_cast<FrameModule*>(PICTURE(picture)->loader);
+
+        for (auto i = first; i < last; ++i) {
+            //a new target resets the canvas, every frame is drawn from scratch
+            if ((result = canvas->target(batch->buffers[i], batch->stride, batch->w, batch->h, batch->cs)) != Result::Success) return;
+            if (loader->frame(batch->begin + batch->step * i)) PAINT(picture)->mark(RenderUpdateFlag::All);
+            if ((result = canvas->draw(true)) != Result::Success) return;
+            if ((result = canvas->sync()) != Result::Success) return;
+        }
+    }
+
+    void run(TVG_UNUSED unsigned tid) override
+    {
+        render();
+    }
+};
+
+
+//an independent instance over the model data of the given picture
+static Picture* _instance(Picture* picture)
+{
+    auto origin = static_cast<FrameModule*>(PICTURE(picture)->loader);
+    auto loader = static_cast<FrameModule*>(origin->share());
+    if (!loader) return nullptr;
+    //the loader keeps no states per user, the instances would compete for it
+    if (loader == origin) return nullptr;
+
+    auto instance = Picture::gen();
+    if (PICTURE(instance)->load(loader) != Result::Success) {
+        delete(instance);
+        return nullptr;
+    }
+    loader->segment(origin->segmentBegin, origin->segmentEnd);
+    instance->size(PICTURE(picture)->w, PICTURE(picture)->h);
+    return instance;
+}
+
+
+//the rendered frames of an animation, the picture of the animation draws them instead of its scene
+struct FrameCache : PictureCache
+{
+    struct Frame
+    {
+        float no;
+        RenderRegion rect;           //the area differs from the base frame, the whole area for the base
+        uint32_t* data;
+    };
+
+    Picture* origin;                 //the picture of the animation
+    Picture* picture = nullptr;      //the instance over the shared model, renders the missing frames
+    SwCanvas* canvas = nullptr;
+    Array<Frame> frames;             //frames[0] is the base frame of the compression
+    RenderSurface surface;           //the image of the current frame
+    uint32_t budget;                 //the limit of the stored frames in bytes
+    uint32_t used = 0;
+    float no = 0.0f;                 //the current frame number
+    float key = 0.0f;                //the current frame number after shortening, identifies the frame
+    bool compress;                   //store the frames by the differences from the base frame
+    bool enabled = false;            //the picture draws the cached frames
+    bool dirty = false;              //the surface doesn't have the current frame yet
+
+    FrameCache(Picture* origin, uint32_t budget, bool compress) : origin(origin), budget(budget), compress(compress)
+    {
+        surface.channelSize = sizeof(uint32_t);
+        surface.premultiplied = true;
+    }
+
+    ~FrameCache()
+    {
+        clear();
+        delete(canvas);
+        tvg::free(surface.buf32);
+    }
+
+    bool active() override
+    {
+        return enabled;
+    }
+
+    RenderSurface* fetch(ColorSpace cs, uint32_t w, uint32_t h) override
+    {
+        //the stored frames of the other resolution are useless
+        if (cs != surface.cs || w != surface.w || h != surface.h) {
+            clear();
+            surface.buf32 = tvg::realloc<uint32_t*>(surface.buf32, w * h * sizeof(uint32_t));
+            surface.stride = surface.w = w;
+            surface.h = h;
+            surface.cs = cs;
+            picture->size(float(w), float(h));
+            dirty = true;
+        }
+
+        if (dirty) {
+            if (auto frame = find(key)) {
+                decode(*frame);
+            } else if (render()) {
+                store();
+            } else {
+                suspend(true);
+                return nullptr;
+            }
+            dirty = false;
+        }
+        return &surface;
+    }
+
+    Result frame(float no)
+    {
+        auto loader = static_cast<FrameModule*>(PICTURE(origin)->loader);
+        auto key = loader->shorten(no);
+
+        //Skip update if frame diff is too small.
+        if (enabled && fabsf(this->key - key) <= 0.0009f) return Result::InsufficientCondition;
+
+        //the instance could be lost by the changes of the animation contents
+        if (!picture && !prepare()) {
+            suspend(false);
+            return Result::NonSupport;
+        }
+
+        this->no = no;
+        this->key = key;
+        enabled = dirty = true;
+        return Result::Success;
+    }
+
+    bool prepare()
+    {
+        if (!canvas && !(canvas = SwCanvas::gen())) return false;
+        if (!(picture = _instance(origin))) return false;
+        if (surface.w > 0) picture->size(float(surface.w), float(surface.h));
+        canvas->push(picture);
+        return true;
+    }
+
+    //the picture of the animation goes back to its own scene
+    void suspend(bool sync)
+    {
+        if (!enabled) return;
+        enabled = false;
+        if (sync) {
+            auto loader = static_cast<FrameModule*>(PICTURE(origin)->loader);
+            auto pending = PICTURE(origin)->wait();
+            if (loader->frame(no) && pending) loader->sync();
+        }
+        PAINT(origin)->mark(RenderUpdateFlag::All);
+    }
+
+    //drops the stored frames and the instance, they don't reflect the current contents
+    void reset()
+    {
+        clear();
+        if (canvas) canvas->remove();
+        picture = nullptr;
+    }
+
+    void clear()
+    {
+        ARRAY_FOREACH(p, frames) tvg::free(p->data);
+        frames.clear();
+        used = 0;
+    }
+
+    Frame* find(float key)
+    {
+        ARRAY_FOREACH(p, frames) {
+            if (fabsf(p->no - key) <= 0.0009f) return p;
+        }
+        return nullptr;
+    }
+
+    bool render()
+    {
+        auto origin = static_cast<FrameModule*>(PICTURE(this->origin)->loader);
+        auto loader = static_cast<FrameModule*>(PICTURE(picture)->loader);
+
+        if (origin->segmentBegin != loader->segmentBegin || origin->segmentEnd != loader->segmentEnd) {
+            loader->segment(origin->segmentBegin, origin->segmentEnd);
+        }
+        if (loader->frame(no)) PAINT(picture)->mark(RenderUpdateFlag::All);
+
+        //a new target resets the canvas, the surface could have been overwritten by the stored frames
+        if (canvas->target(surface.buf32, surface.stride, surface.w, surface.h, surface.cs) != Result::Success) return false;
+        if (canvas->draw(true) != Result::Success) return false;
+        return canvas->sync() == Result::Success;
+    }
+
+    //the bounding box of the pixels differ from the base frame
+    RenderRegion diff(const Frame& base)
+    {
+        RenderRegion rect = {{int32_t(surface.w), int32_t(surface.h)}, {0, 0}};
+        for (uint32_t y = 0; y < surface.h; ++y) {
+            auto src = surface.buf32 + y * surface.stride;
+            auto dst = base.data + y * surface.w;
+            if (!memcmp(src, dst, surface.w * sizeof(uint32_t))) continue;
+            uint32_t x1 = 0, x2 = surface.w;
+            while (src[x1] == dst[x1]) ++x1;
+            while (src[x2 - 1] == dst[x2 - 1]) --x2;
+            rect.add({{int32_t(x1), int32_t(y)}, {int32_t(x2), int32_t(y + 1)}});
+        }
+        if (rect.invalid()) return {{0, 0}, {0, 0}};
+        return rect;
+    }
+
+    void store()
+    {
+        Frame frame = {key, {{0, 0}, {int32_t(surface.w), int32_t(surface.h)}}, nullptr};
+        if (compress && !frames.empty()) frame.rect = diff(frames[0]);
+
+        auto size = frame.rect.w() * frame.rect.h() * sizeof(uint32_t);
+        if (used + size > budget && !evict(size)) return;
+
+        if (size > 0) {
+            frame.data = tvg::malloc<uint32_t*>(size);
+            for (auto y = frame.rect.min.y; y < frame.rect.max.y; ++y) {
+                memcpy(frame.data + (y - frame.rect.min.y) * frame.rect.w(), surface.buf32 + y * surface.stride + frame.rect.min.x, frame.rect.w() * sizeof(uint32_t));
+            }
+        }
+        frames.push(frame);
+        used += size;
+    }
+
+    //drops the oldest frames until the new one fits, the base frame stays while the others are laid over it
+    bool evict(size_t size)
+    {
+        auto begin = compress ? 1U : 0U;
+        auto end = begin;
+        for (; end < frames.count && used + size > budget; ++end) {
+            used -= frames[end].rect.w() * frames[end].rect.h() * sizeof(uint32_t);
+            tvg::free(frames[end].data);
+        }
+        if (end > begin) {
+            memmove(frames.data + begin, frames.data + end, (frames.count - end) * sizeof(Frame));
+            frames.count -= (end - begin);
+        }
+        return used + size <= budget;
+    }
+
+    void decode(const Frame& frame)
+    {
+        //a partial frame is laid over the base
+        if (frame.rect.w() != surface.w || frame.rect.h() != surface.h) memcpy(surface.buf32, frames[0].data, surface.w * surface.h * sizeof(uint32_t));
+        for (auto y = frame.rect.min.y; y < frame.rect.max.y; ++y) {
+            memcpy(surface.buf32 + y * surface.stride + frame.rect.min.x, frame.data + (y - frame.rect.min.y) * frame.rect.w(), frame.rect.w() * sizeof(uint32_t));
+        }
+    }
+};
+
+/************************************************************************/
+/* External Class Implementation                                        */
+/************************************************************************/
+
+Animation::Impl::~Impl()
+{
+    //the picture might be still drawn by the others, it goes back to the scene of the current frame
+    if (cache) {
+        cache->suspend(true);
+        PICTURE(picture)->uncache();
+        delete(cache);
+    }
+    if (monitor) {
+        PICTURE(picture)->monitor = nullptr;
+        delete(monitor);
+    }
+    picture->unref();
+}
+
+
+void Animation::Impl::invalidate(bool outdated)
+{
+    if (!cache) return;
+
+    //the loader takes the frame by itself on tweening
+    cache->suspend(outdated);
+    if (outdated) cache->reset();
+}
+
+
 
 Animation::~Animation()
 {
@@ -42,7 +353,16 @@ Result Animation::frame(float no) noexcept
     if (!loader) return Result::InsufficientCondition;
     if (!loader->animatable()) return Result::NonSupport;
 
+    if (pImpl->cache) {
+        auto ret = pImpl->cache->frame(no);
+        if (ret == Result::Success) PAINT(pImpl->picture)->mark(RenderUpdateFlag::Image);
+        if (ret != Result::NonSupport) return ret;
+    }
+
+    auto pending = PICTURE(pImpl->picture)->wait();
+
     if (static_cast<FrameModule*>(loader)->frame(no)) {
+        if (pending) loader->sync();
         PAINT(pImpl->picture)->mark(RenderUpdateFlag::All);
         return Result::Success;
     }
@@ -63,6 +383,9 @@ float Animation::curFrame() const noexcept
     if (!loader) return 0;
     if (!loader->animatable()) return 0;
 
+    //the loader stays at the frame prior to the cached ones
+    if (pImpl->cache && pImpl->cache->enabled) return pImpl->cache->key - static_cast<FrameModule*>(loader)->segmentBegin;
+
     return static_cast<FrameModule*>(loader)->curFrame();
 }
 
@@ -112,6 +435,106 @@ Result Animation::segment(float *begin, float *end) noexcept
 }
 
 
+Result Animation::render(uint32_t** buffers, uint32_t cnt, uint32_t stride, uint32_t w, uint32_t h, ColorSpace cs, float begin, float step) noexcept
+{
+    auto loader = PICTURE(pImpl->picture)->loader;
+    if (!loader) return Result::InsufficientCondition;
+    if (!loader->animatable()) return Result::NonSupport;
+    if (!buffers || w == 0 || h == 0 || stride < w) return Result::InvalidArguments;
+    for (uint32_t i = 0; i < cnt; ++i) {
+        if (!buffers[i]) return Result::InvalidArguments;
+    }
+    if (cnt == 0) return Result::Success;
+
+    FrameBatch batch = {buffers, stride, w, h, cs, begin, step};
+
+    //one instance per thread, each one takes a run of the adjacent frames
+    auto n = std::min(TaskScheduler::threads() + 1, cnt);
+    Array<FrameWorker*> workers(n);
+
+    auto result = Result::Success;
+
+    for (uint32_t k = 0; k < n; ++k) {
+        auto picture = _instance(pImpl->picture);
+        if (!picture) {
+            result = Result::NonSupport;
+            break;
+        }
+        //the canvases are created here, on the thread of the caller
+        auto canvas = SwCanvas::gen();
+        if (!canvas) {
+            delete(picture);
+            result = Result::NonSupport;
+            break;
+        }
+        picture->transform(pImpl->picture->transform());
+        picture->opacity(pImpl->picture->opacity());
+        canvas->push(picture);
+        auto worker = new FrameWorker(&batch);
+        worker->canvas = canvas;
+        worker->picture = picture;
+        workers.push(worker);
+    }
+
+    if (workers.count > 0) {
+        result = Result::Success;
+        n = workers.count;
+        for (uint32_t k = 0; k < n; ++k) {
+            workers[k]->first = k * cnt / n;
+            workers[k]->last = (k + 1) * cnt / n;
+        }
+        for (uint32_t k = 1; k < n; ++k) TaskScheduler::request(workers[k]);
+        workers[0]->render();
+
+        ARRAY_FOREACH(p, workers) {
+            (*p)->done();
+            if (result == Result::Success) result = (*p)->result;
+        }
+    }
+
+    ARRAY_FOREACH(p, workers) delete(*p);
+
+    return result;
+}
+
+
+Result Animation::cache(uint32_t budget, bool compress) noexcept
+{
+    auto loader = PICTURE(pImpl->picture)->loader;
+    if (!loader) return Result::InsufficientCondition;
+    if (!loader->animatable()) return Result::NonSupport;
+
+    if (budget == 0) {
+        if (pImpl->cache) {
+            pImpl->cache->suspend(true);
+            PICTURE(pImpl->picture)->uncache();
+            delete(pImpl->cache);
+            pImpl->cache = nullptr;
+        }
+        return Result::Success;
+    }
+
+    if (pImpl->cache) {
+        //the stored frames are kept unless they don't fit the new conditions
+        if (pImpl->cache->compress != compress) pImpl->cache->clear();
+        pImpl->cache->budget = budget;
+        pImpl->cache->compress = compress;
+        if (!pImpl->cache->evict(0)) pImpl->cache->clear();
+        return Result::Success;
+    }
+
+    auto cache = new FrameCache(pImpl->picture, budget, compress);
+    if (!cache->prepare()) {
+        delete(cache);
+        return Result::NonSupport;
+    }
+    pImpl->cache = cache;
+    PICTURE(pImpl->picture)->cache = cache;
+
+    return Result::Success;
+}
+
+
 Animation* Animation::gen() noexcept
 {
     return new Animation;
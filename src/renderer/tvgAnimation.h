@@ -26,9 +26,13 @@
 #include "tvgCommon.h"
 #include "tvgPicture.h"
 
+struct FrameCache;
+
 struct Animation::Impl
 {
     Picture* picture = nullptr;
+    FrameCache* cache = nullptr;   //the rendered frames, optional
+    PictureMonitor* monitor = nullptr;   //the frame time governor, optional
 
     Impl()
     {
@@ -36,10 +40,9 @@ struct Animation::Impl
         picture->ref();
     }
 
-    ~Impl()
-    {
-        picture->unref();
-    }
+    ~Impl();
+
+    void invalidate(bool outdated);  //the picture shows the own scene from now
 };
 
 #endif //_TVG_ANIMATION_H_
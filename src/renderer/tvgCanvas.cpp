@@ -58,7 +58,7 @@ Result Canvas::draw(bool clear) noexcept
 Result Canvas::update() noexcept
 {
     TVGLOG("RENDERER", "Update S. ------------------------------ Canvas(%p)", this);
-    if (pImpl->scene->paints().empty() || pImpl->status == Status::Drawing) return Result::InsufficientCondition;
+    if (SCENE(pImpl->scene)->paints.empty() || pImpl->status == Status::Drawing) return Result::InsufficientCondition;
     auto ret = pImpl->update(nullptr, false);
     TVGLOG("RENDERER", "Update E. ------------------------------ Canvas(%p)", this);
 
@@ -23,7 +23,7 @@
 #ifndef _TVG_CANVAS_H_
 #define _TVG_CANVAS_H_
 
-#include "tvgPaint.h"
+#include "tvgScene.h"
 
 enum Status : uint8_t {Synced = 0, Updating, Drawing, Damaged};
 
@@ -87,7 +87,7 @@ struct Canvas::Impl
     {
         if (status == Status::Drawing) return Result::InsufficientCondition;
         if (clear && !renderer->clear()) return Result::InsufficientCondition;
-        if (scene->paints().empty()) return Result::InsufficientCondition;
+        if (SCENE(scene)->paints.empty()) return Result::InsufficientCondition;
         if (status == Status::Damaged) update(nullptr, false);
         if (!renderer->preRender()) return Result::InsufficientCondition;
 
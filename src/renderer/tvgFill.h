@@ -53,6 +53,13 @@ struct Fill::Impl
         transform = dup.transform;
     }
 
+    bool operator==(const Fill::Impl& rhs) const
+    {
+        if (cnt != rhs.cnt || spread != rhs.spread || memcmp(&transform, &rhs.transform, sizeof(Matrix))) return false;
+        if (cnt > 0 && memcmp(colorStops, rhs.colorStops, sizeof(ColorStop) * cnt)) return false;
+        return true;
+    }
+
     Result update(const ColorStop* colorStops, uint32_t cnt)
     {
         if ((!colorStops && cnt > 0) || (colorStops && cnt == 0)) return Result::InvalidArguments;
@@ -217,4 +224,21 @@ struct LinearGradientImpl :  LinearGradient
 };
 
 
+//compare the gradient properties
+static inline bool equal(const Fill* lhs, const Fill* rhs)
+{
+    if (lhs == rhs) return true;
+    if (!lhs || !rhs || lhs->type() != rhs->type()) return false;
+
+    if (lhs->type() == tvg::Type::LinearGradient) {
+        auto l = CONST_LINEAR(lhs);
+        auto r = CONST_LINEAR(rhs);
+        return l->impl == r->impl && l->x1 == r->x1 && l->y1 == r->y1 && l->x2 == r->x2 && l->y2 == r->y2;
+    }
+
+    auto l = CONST_RADIAL(lhs);
+    auto r = CONST_RADIAL(rhs);
+    return l->impl == r->impl && l->cx == r->cx && l->cy == r->cy && l->r == r->r && l->fx == r->fx && l->fy == r->fy && l->fr == r->fr;
+}
+
 #endif  //_TVG_FILL_H_
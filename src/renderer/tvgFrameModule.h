@@ -42,6 +42,7 @@ public:
     virtual float curFrame() = 0;           //return the current frame number
     virtual float duration() = 0;           //return the animation duration in seconds
     virtual Result segment(float begin, float end) = 0;
+    virtual float shorten(float no) { return no + segmentBegin; }  //the absolute frame number as the loader takes it
 
     void segment(float* begin, float* end)
     {
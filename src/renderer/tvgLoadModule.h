@@ -64,6 +64,7 @@ struct LoadModule
     virtual bool open(const char* data, uint32_t size, const char* rpath, bool copy) { return false; }
     virtual bool resize(Paint* paint, float w, float h) { return false; }
     virtual void sync() {};  //finish immediately if any async update jobs.
+    virtual bool synced() { return true; }  //false if any changes are waiting for sync().
 
     virtual bool read()
     {
@@ -78,6 +79,9 @@ struct LoadModule
         --sharing;
         return false;
     }
+
+    //the loader for another user of the cached one, a new instance if the loader has any states per user.
+    virtual LoadModule* share() { return this; }
 };
 
 
@@ -166,7 +166,7 @@ static LoadModule* _findByPath(const char* filename)
     if (!ext) return nullptr;
 
     if (!strcmp(ext, "svg")) return _find(FileType::Svg);
-    if (!strcmp(ext, "lot") || !strcmp(ext, "json")) return _find(FileType::Lot);
+    if (!strcmp(ext, "lot") || !strcmp(ext, "lotb") || !strcmp(ext, "json")) return _find(FileType::Lot);
     if (!strcmp(ext, "png")) return _find(FileType::Png);
     if (!strcmp(ext, "jpg")) return _find(FileType::Jpg);
     if (!strcmp(ext, "webp")) return _find(FileType::Webp);
@@ -185,7 +185,7 @@ static FileType _convert(const char* mimeType)
 
     if (!strcmp(mimeType, "svg") || !strcmp(mimeType, "svg+xml")) type = FileType::Svg;
     else if (!strcmp(mimeType, "ttf") || !strcmp(mimeType, "otf")) type = FileType::Ttf;
-    else if (!strcmp(mimeType, "lot") || !strcmp(mimeType, "lottie+json")) type = FileType::Lot;
+    else if (!strcmp(mimeType, "lot") || !strcmp(mimeType, "lotb") || !strcmp(mimeType, "lottie+json")) type = FileType::Lot;
     else if (!strcmp(mimeType, "raw")) type = FileType::Raw;
     else if (!strcmp(mimeType, "png")) type = FileType::Png;
     else if (!strcmp(mimeType, "jpg") || !strcmp(mimeType, "jpeg")) type = FileType::Jpg;
@@ -277,13 +277,24 @@ LoadModule* LoaderMgr::loader(const char* filename, bool* invalid)
 #ifdef THORVG_FILE_IO_SUPPORT
     *invalid = false;
 
-    //TODO: svg & lottie is not sharable.
+    //TODO: svg is not sharable.
     auto allowCache = true;
     auto ext = fileext(filename);
-    if (ext && (!strcmp(ext, "svg") || !strcmp(ext, "json") || !strcmp(ext, "lot"))) allowCache = false;
+    if (ext && !strcmp(ext, "svg")) allowCache = false;
 
     if (allowCache) {
-        if (auto loader = _findFromCache(filename)) return loader;
+        if (auto loader = _findFromCache(filename)) {
+            auto instance = loader->share();
+            if (instance == loader) return loader;
+            retrieve(loader);
+            //the instance over the shared data, could be a cache for the next one.
+            if (instance) {
+                instance->cache(duplicate(filename));
+                ScopedLock lock(_key);
+                _activeLoaders.back(instance);
+                return instance;
+            }
+        }
     }
 
     if (auto loader = _findByPath(filename)) {
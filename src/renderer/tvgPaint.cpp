@@ -145,18 +145,44 @@ Iterator* Paint::Impl::iterator()
 
 Paint* Paint::Impl::duplicate(Paint* ret)
 {
-    if (ret) ret->mask(nullptr, MaskMethod::None);
+    auto recycled = ret ? true : false;
+
+    //the mask and the clipper of the recycled one are recycled as well if they are the same kinds
+    if (ret) {
+        auto dst = ret->pImpl;
+        if (!maskData || !dst->maskData || dst->maskData->method != maskData->method || dst->maskData->target->type() != maskData->target->type()) {
+            ret->mask(nullptr, MaskMethod::None);
+        }
+        if (!clipper) ret->clip(nullptr);
+    }
 
     PAINT_METHOD(ret, duplicate(ret));
 
-    //duplicate Transform
-    ret->pImpl->tr = tr;
-    ret->pImpl->mark(RenderUpdateFlag::Transform);
+    //duplicate Transform, the recycled one is marked only by the changes
+    auto dst = ret->pImpl;
+    if (!recycled || dst->tr.overriding != tr.overriding || dst->tr.degree != tr.degree || dst->tr.scale != tr.scale || memcmp(&dst->tr.m, &tr.m, sizeof(Matrix))) {
+        dst->tr = tr;
+        dst->mark(RenderUpdateFlag::Transform);
+    }
+
+    if (dst->opacity != opacity) {
+        dst->opacity = opacity;
+        dst->mark(RenderUpdateFlag::Color);
+    }
 
-    ret->pImpl->opacity = opacity;
+    if (dst->blendMethod != blendMethod) {
+        dst->blendMethod = blendMethod;
+        dst->mark(RenderUpdateFlag::Blend);
+    }
 
-    if (maskData) ret->mask(maskData->target->duplicate(), maskData->method);
-    if (clipper) ret->clip(static_cast<Shape*>(clipper->duplicate()));
+    if (maskData) {
+        if (dst->maskData) PAINT(maskData->target)->duplicate(dst->maskData->target);
+        else ret->mask(maskData->target->duplicate(), maskData->method);
+    }
+    if (clipper) {
+        if (dst->clipper) PAINT(clipper)->duplicate(dst->clipper);
+        else ret->clip(static_cast<Shape*>(clipper->duplicate()));
+    }
 
     return ret;
 }
@@ -59,10 +59,10 @@ namespace tvg
         RenderData rd = nullptr;
 
         struct {
-            Matrix m;                 //input matrix
-            float degree;             //rotation degree
-            float scale;              //scale factor
-            bool overriding;          //user transform?
+            Matrix m = {1, 0, 0, 0, 1, 0, 0, 0, 1};   //input matrix
+            float degree = 0.0f;                      //rotation degree
+            float scale = 1.0f;                       //scale factor
+            bool overriding = false;                  //user transform?
 
             void update()
             {
@@ -80,10 +80,10 @@ namespace tvg
         } tr;
         RenderUpdateFlag renderFlag = RenderUpdateFlag::None;
         CompositionFlag cmpFlag = CompositionFlag::Invalid;
-        BlendMethod blendMethod;
+        BlendMethod blendMethod = BlendMethod::Normal;
         uint16_t refCnt = 0;       //reference count
         uint8_t ctxFlag;           //See enum ContextFlag
-        uint8_t opacity;
+        uint8_t opacity = 255;
         bool hidden : 1;
 
         Impl(Paint* pnt) : paint(pnt)
@@ -163,7 +163,11 @@ namespace tvg
 
         bool transform(const Matrix& m)
         {
-            if (&tr.m != &m) tr.m = m;
+            if (&tr.m != &m) {
+                //compared exactly, the slightly different one must be still updated
+                if (tr.overriding && !memcmp(&tr.m, &m, sizeof(Matrix))) return true;
+                tr.m = m;
+            }
             tr.overriding = true;
             mark(RenderUpdateFlag::Transform);
 
@@ -245,6 +249,13 @@ namespace tvg
                 maskData = nullptr;
             }
 
+            //keep the pending updates, mark the properties differed from the render data
+            if (tr.overriding || !tvg::equal(tr.degree, 0.0f) || !tvg::equal(tr.scale, 1.0f) || !tvg::identity((const Matrix*)&tr.m)) {
+                mark(RenderUpdateFlag::Transform);
+            }
+            if (opacity != 255) mark(RenderUpdateFlag::Color);
+            if (blendMethod != BlendMethod::Normal) mark(RenderUpdateFlag::Blend);
+
             tvg::identity(&tr.m);
             tr.degree = 0.0f;
             tr.scale = 1.0f;
@@ -252,7 +263,6 @@ namespace tvg
 
             parent = nullptr;
             blendMethod = BlendMethod::Normal;
-            renderFlag = RenderUpdateFlag::None;
             ctxFlag = ContextFlag::Default;
             opacity = 255;
             paint->id = 0;
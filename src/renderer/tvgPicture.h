@@ -57,12 +57,33 @@ struct PictureIterator : Iterator
 };
 
 
+//supplies the prerendered images of the vector scene, such as the cached animation frames
+struct PictureCache
+{
+    virtual ~PictureCache() {}
+    virtual bool active() = 0;
+    virtual RenderSurface* fetch(ColorSpace cs, uint32_t w, uint32_t h) = 0;  //the image of w x h pixels, nullptr if not available
+};
+
+
+//watches the picture from its updating to the end of its drawing
+struct PictureMonitor
+{
+    virtual ~PictureMonitor() {}
+    virtual void begin() = 0;
+    virtual void end() = 0;
+};
+
+
 struct PictureImpl : Picture
 {
     Paint::Impl impl;
     ImageLoader* loader = nullptr;
     Paint* vector = nullptr;          //vector picture uses
     RenderSurface* bitmap = nullptr;  //bitmap picture uses
+    PictureCache* cache = nullptr;    //replaces the vector while it's active
+    RenderSurface* frame = nullptr;   //the current image of the cache
+    PictureMonitor* monitor = nullptr;
     float w = 0, h = 0;
     bool resizing = false;
 
@@ -76,14 +97,57 @@ struct PictureImpl : Picture
         delete(vector);
     }
 
+    //the loader rebuilds the scene in place, the render data of the last update must not read it meanwhile.
+    //true if the scene is prepared but not drawn yet, then the rebuild must be finished prior to the drawing.
+    bool wait()
+    {
+        return impl.renderer && impl.renderer->wait();
+    }
+
+    //the image of the cache is going away, the render data must not refer to it any longer
+    void uncache()
+    {
+        if (frame && impl.rd) {
+            impl.renderer->dispose(impl.rd);
+            impl.rd = nullptr;
+            impl.mark(RenderUpdateFlag::All);
+        }
+        frame = nullptr;
+        cache = nullptr;
+    }
+
     bool skip(RenderUpdateFlag flag)
     {
-        if (flag == RenderUpdateFlag::None) return true;
+        //the loader changed the contents by itself, the changed paints are updated only
+        if (flag == RenderUpdateFlag::None) return !loader || loader->synced();
         return false;
     }
 
+    //draw the image of the cache in the device resolution, the rest of the transform is applied to it.
+    bool prerendered(RenderMethod* renderer, const Matrix& transform, Array<RenderData>& clips, uint8_t opacity, RenderUpdateFlag flag)
+    {
+        frame = nullptr;
+        if (!cache || !cache->active()) return false;
+
+        auto sx = sqrtf(transform.e11 * transform.e11 + transform.e21 * transform.e21);
+        auto sy = sqrtf(transform.e12 * transform.e12 + transform.e22 * transform.e22);
+        auto iw = static_cast<uint32_t>(nearbyintf(w * sx));
+        auto ih = static_cast<uint32_t>(nearbyintf(h * sy));
+        if (iw == 0 || ih == 0) return false;
+
+        if (!(frame = cache->fetch(renderer->colorSpace(), iw, ih))) return false;
+
+        auto m = transform * Matrix{w / iw, 0, 0, 0, h / ih, 0, 0, 0, 1};
+        impl.rd = renderer->prepare(frame, impl.rd, m, clips, opacity, flag);
+        return true;
+    }
+
     bool update(RenderMethod* renderer, const Matrix& transform, Array<RenderData>& clips, uint8_t opacity, RenderUpdateFlag flag, TVG_UNUSED bool clipper)
     {
+        if (monitor) monitor->begin();
+
+        if (prerendered(renderer, transform, clips, opacity, flag)) return true;
+
         load();
 
         if (bitmap) {
@@ -94,6 +158,11 @@ struct PictureImpl : Picture
             auto m = transform * Matrix{scale, 0, 0, 0, scale, 0, 0, 0, 1};
             impl.rd = renderer->prepare(bitmap, impl.rd, m, clips, opacity, flag);
         } else if (vector) {
+            //back from the cached images
+            if (impl.rd) {
+                renderer->dispose(impl.rd);
+                impl.rd = nullptr;
+            }
             if (resizing) {
                 loader->resize(vector, w, h);
                 resizing = false;
@@ -124,7 +193,7 @@ struct PictureImpl : Picture
     {
         if (!impl.renderer) return false;
         load();
-        if (impl.rd) return impl.renderer->intersectsImage(impl.rd, region);
+        if (impl.rd && (bitmap || frame)) return impl.renderer->intersectsImage(impl.rd, region);
         else if (vector) return SCENE(vector)->intersects(region);
         return false;
     }
@@ -225,6 +294,7 @@ struct PictureImpl : Picture
     {
         if (loader) {
             if (vector) {
+                wait();
                 loader->sync();
             } else if ((vector = loader->paint())) {
                 PAINT(vector)->parent = this;
@@ -260,9 +330,9 @@ struct PictureImpl : Picture
     {
         auto ret = true;
 
-        if (bitmap) {
+        if (bitmap || frame) {
             renderer->blend(impl.blendMethod);
-            return renderer->renderImage(impl.rd);
+            ret = renderer->renderImage(impl.rd);
         } else if (vector) {
             RenderCompositor* cmp = nullptr;
             if (impl.cmpFlag) {
@@ -272,12 +342,17 @@ struct PictureImpl : Picture
             ret = vector->pImpl->render(renderer);
             if (cmp) renderer->endComposite(cmp);
         }
+        if (monitor) monitor->end();
         return ret;
     }
 
     RenderRegion bounds(RenderMethod* renderer)
     {
-        if (vector) return vector->pImpl->bounds(renderer);
+        if (vector && !frame) {
+            //the loader might be rebuilding the scene, i.e. the picture is removed right after a frame change.
+            if (loader) loader->sync();
+            return vector->pImpl->bounds(renderer);
+        }
         return renderer->region(impl.rd);
     }
 
@@ -193,6 +193,8 @@ bool RenderDirtyRegion::add(const RenderRegion& prv, const RenderRegion& cur)
 
 void RenderDirtyRegion::clear()
 {
+    //the tasks skipped by the full drawing could be still adding their regions
+    ScopedLock lock(key);
     for (int idx = 0; idx < PARTITIONING; ++idx) {
         partitions[idx].list[0].clear();
         partitions[idx].list[1].clear();
@@ -200,8 +202,14 @@ void RenderDirtyRegion::clear()
 }
 
 
-void RenderDirtyRegion::subdivide(Array<RenderRegion>& targets, uint32_t idx, RenderRegion& lhs, RenderRegion& rhs)
+bool RenderDirtyRegion::subdivide(Array<RenderRegion>& targets, uint32_t idx, RenderRegion& lhs, RenderRegion& rhs)
 {
+    //one intersection can be divided up to 5. keep both regions as they are if there is no room, don't lose any.
+    if (targets.count + 4 > targets.reserved) {
+        TVGLOG("RENDERER", "reserved(%d), required(%d)", targets.reserved, targets.count + 4);
+        return false;
+    }
+
     RenderRegion temp[5];
     int cnt = 0;
     temp[cnt++] = RenderRegion::intersect(lhs, rhs);
@@ -233,12 +241,6 @@ void RenderDirtyRegion::subdivide(Array<RenderRegion>& targets, uint32_t idx, Re
     subtract(temp[0], lhs);
     subtract(temp[0], rhs);
 
-    //Please reserve memory enough with targets.reserve()
-    if (targets.count + cnt - 1 > targets.reserved) {
-        TVGERR("RENDERER", "reserved(%d), required(%d)", targets.reserved, targets.count + cnt - 1);
-        return;
-    }
-
     /* Considered using a list to avoid memory shifting,
        but ultimately, the array outperformed the list due to better cache locality. */
 
@@ -253,6 +255,7 @@ void RenderDirtyRegion::subdivide(Array<RenderRegion>& targets, uint32_t idx, Re
     stable_sort(&targets[idx], dst, [](const RenderRegion& a, const RenderRegion& b) -> bool {
         return a.min.x < b.min.x;
     });
+    return true;
 }
 
 
@@ -318,8 +321,7 @@ void RenderDirtyRegion::commit()
                     }
                 }
                 //subdivide regions
-                if (lhs.intersected(rhs)) {
-                    subdivide(targets, j, lhs, rhs);
+                if (lhs.intersected(rhs) && subdivide(targets, j, lhs, rhs)) {
                     merged = true;
                     break;
                 }
@@ -541,6 +543,7 @@ bool RenderTrimPath::trim(const RenderPath& in, RenderPath& out) const
     float begin = this->begin, end = this->end;
     _get(begin, end);
 
+    out.detach();
     out.cmds.reserve(in.cmds.count * 2);
     out.pts.reserve(in.pts.count * 2);
 
@@ -776,6 +779,7 @@ bool RenderShape::strokeDash(RenderPath& out) const
 {
     if (!stroke || stroke->dash.count == 0 || stroke->dash.length < DASH_PATTERN_THRESHOLD) return false;
 
+    out.detach();
     out.cmds.reserve(20 * path.cmds.count);
     out.pts.reserve(20 * path.pts.count);
 
@@ -25,6 +25,7 @@
 
 #include <math.h>
 #include <cstdarg>
+#include <atomic>
 #include "tvgCommon.h"
 #include "tvgArray.h"
 #include "tvgLock.h"
@@ -188,7 +189,7 @@ struct RenderRegion
         }
 
     private:
-        void subdivide(Array<RenderRegion>& targets, uint32_t idx, RenderRegion& lhs, RenderRegion& rhs);
+        bool subdivide(Array<RenderRegion>& targets, uint32_t idx, RenderRegion& lhs, RenderRegion& rhs);
 
         struct Partition
         {
@@ -221,8 +222,77 @@ struct RenderRegion
 
 struct RenderPath
 {
+    //path data shared among the duplicated paths, copied on the first write
+    struct Shared
+    {
+        Array<PathCommand> cmds;
+        Array<Point> pts;
+        atomic<uint32_t> refCnt{};    //the duplicated paths may be released by the other threads
+    };
+
     Array<PathCommand> cmds;
     Array<Point> pts;
+    Shared* shared = nullptr;   //not null if cmds & pts borrow the shared data
+
+    RenderPath() = default;
+
+    RenderPath(const RenderPath& rhs)
+    {
+        cmds = rhs.cmds;
+        pts = rhs.pts;
+    }
+
+    ~RenderPath()
+    {
+        release();
+    }
+
+    void operator=(const RenderPath& rhs)
+    {
+        if (this == &rhs) return;
+        release();
+        cmds = rhs.cmds;
+        pts = rhs.pts;
+    }
+
+    //borrow the path data of the rhs without copying it
+    void share(RenderPath& rhs)
+    {
+        if (this == &rhs || (shared && shared == rhs.shared)) return;
+        release();
+        //drop the own data, it's replaced by the borrowed one
+        cmds.reset();
+        pts.reset();
+        if (rhs.pts.empty()) return;
+        if (!rhs.shared) {
+            rhs.shared = new Shared;
+            rhs.cmds.move(rhs.shared->cmds);
+            rhs.pts.move(rhs.shared->pts);
+            rhs.borrow();
+            ++rhs.shared->refCnt;
+        }
+        shared = rhs.shared;
+        ++shared->refCnt;
+        borrow();
+    }
+
+    //take the own copy of the path data prior to any modification
+    void detach()
+    {
+        if (!shared) return;
+        auto src = shared;
+        unborrow();
+        //the last owner takes over the data, the others copy it
+        if (src->refCnt > 1) {
+            cmds = src->cmds;
+            pts = src->pts;
+            if (--src->refCnt == 0) delete(src);
+        } else {
+            src->cmds.move(cmds);
+            src->pts.move(pts);
+            delete(src);
+        }
+    }
 
     bool empty()
     {
@@ -231,6 +301,7 @@ struct RenderPath
 
     void clear()
     {
+        release();
         pts.clear();
         cmds.clear();
     }
@@ -239,23 +310,27 @@ struct RenderPath
     {
         //Don't close multiple times.
         if (cmds.count > 0 && cmds.last() == PathCommand::Close) return;
+        detach();
         cmds.push(PathCommand::Close);
     }
 
     void moveTo(const Point& pt)
     {
+        detach();
         pts.push(pt);
         cmds.push(PathCommand::MoveTo);
     }
 
     void lineTo(const Point& pt)
     {
+        detach();
         pts.push(pt);
         cmds.push(PathCommand::LineTo);
     }
 
     void cubicTo(const Point& cnt1, const Point& cnt2, const Point& end)
     {
+        detach();
         pts.push(cnt1);
         pts.push(cnt2);
         pts.push(end);
@@ -263,6 +338,32 @@ struct RenderPath
     }
 
     bool bounds(Matrix* m, float* x, float* y, float* w, float* h);
+
+private:
+    void borrow()
+    {
+        cmds.data = shared->cmds.data;
+        cmds.count = cmds.reserved = shared->cmds.count;
+        pts.data = shared->pts.data;
+        pts.count = pts.reserved = shared->pts.count;
+    }
+
+    void unborrow()
+    {
+        cmds.data = nullptr;
+        cmds.count = cmds.reserved = 0;
+        pts.data = nullptr;
+        pts.count = pts.reserved = 0;
+        shared = nullptr;
+    }
+
+    void release()
+    {
+        if (!shared) return;
+        auto src = shared;
+        unborrow();
+        if (--src->refCnt == 0) delete(src);
+    }
 };
 
 struct RenderTrimPath
@@ -330,9 +431,19 @@ struct RenderStroke
     }
 };
 
+//a glyph of the text layout, its outline is a part of the text path
+struct RenderGlyph
+{
+    uint64_t id;        //unique among the glyphs of all the fonts
+    Point origin;       //the pen position in the path coordinates
+    uint32_t cmds;      //the first command of the glyph outline in the path
+    uint32_t pts;       //the first point of the glyph outline in the path
+};
+
 struct RenderShape
 {
     RenderPath path;
+    Array<RenderGlyph> glyphs;   //the glyph layout if the path is composed of the glyph outlines
     Fill *fill = nullptr;
     RenderColor color{};
     RenderStroke *stroke = nullptr;
@@ -564,6 +675,7 @@ public:
     virtual const RenderSurface* mainSurface() = 0;
     virtual bool clear() = 0;
     virtual bool sync() = 0;
+    virtual bool wait() = 0;    //finish the jobs of the prepared data, false if nothing is prepared since the last sync
     virtual bool intersectsShape(RenderData data, const RenderRegion& region) = 0;
     virtual bool intersectsImage(RenderData data, const RenderRegion& region) = 0;
 
@@ -53,7 +53,46 @@ Result Scene::remove(Paint* paint) noexcept
 
 const list<Paint*>& Scene::paints() const noexcept
 {
-    return CONST_SCENE(this)->paints;
+    return const_cast<SceneImpl*>(CONST_SCENE(this))->children();
+}
+
+
+static RenderRegion* _regions(const int32_t* regions, uint32_t cnt)
+{
+    auto ret = tvg::malloc<RenderRegion*>(sizeof(RenderRegion) * cnt);
+    for (uint32_t i = 0; i < cnt; ++i, regions += 4) {
+        ret[i] = {{regions[0], regions[1]}, {regions[0] + regions[2], regions[1] + regions[3]}};
+    }
+    return ret;
+}
+
+
+Result Scene::pick(const int32_t* regions, uint32_t cnt, Paint** hits) noexcept
+{
+    if (!regions || !hits) return Result::InvalidArguments;
+
+    memset(hits, 0x00, sizeof(Paint*) * cnt);
+
+    SceneHitTest test;
+    test.regions = _regions(regions, cnt);
+    test.hits = hits;
+    auto ret = SCENE(this)->intersects(test, cnt);
+    tvg::free((void*)test.regions);
+    return ret;
+}
+
+
+Result Scene::pick(const int32_t* regions, uint32_t cnt, function<bool(uint32_t idx, Paint* paint, void* data)> func, void* data) noexcept
+{
+    if (!regions || !func) return Result::InvalidArguments;
+
+    SceneHitTest test;
+    test.regions = _regions(regions, cnt);
+    test.func = &func;
+    test.data = data;
+    auto ret = SCENE(this)->intersects(test, cnt);
+    tvg::free((void*)test.regions);
+    return ret;
 }
 
 
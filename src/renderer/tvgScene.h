@@ -32,43 +32,192 @@
 
 struct SceneIterator : Iterator
 {
-    list<Paint*>* paints;
-    list<Paint*>::iterator itr;
+    Array<Paint*>* paints;
+    uint32_t idx = 0;
 
-    SceneIterator(list<Paint*>* p) : paints(p)
+    SceneIterator(Array<Paint*>* p) : paints(p)
     {
         begin();
     }
 
     const Paint* next() override
     {
-        if (itr == paints->end()) return nullptr;
-        auto paint = *itr;
-        ++itr;
-        return paint;
+        if (idx >= paints->count) return nullptr;
+        return (*paints)[idx++];
     }
 
     uint32_t count() override
     {
-       return paints->size();
+       return paints->count;
     }
 
     void begin() override
     {
-        itr = paints->begin();
+        idx = 0;
     }
 };
 
+
+//Bounding volume hierarchy over the children render regions.
+struct SceneBvh
+{
+    static constexpr const uint32_t THRESHOLD = 32;  //minimum children count to build the hierarchy
+    static constexpr const uint32_t LEAF_SIZE = 4;
+
+    struct Item
+    {
+        RenderRegion box;
+        uint32_t idx;        //index of the child in the scene
+    };
+
+    struct Node
+    {
+        RenderRegion box;
+        uint32_t first;      //leaf: first item index, branch: index of the left node (the right one follows)
+        uint32_t count;      //leaf: items count, branch: 0
+    };
+
+    Array<Node> nodes;
+    Array<Item> items;
+    Array<uint32_t> visibles;    //the children to be drawn, in the scene order
+    bool dirty = true;
+
+    void build(const Array<Paint*>& paints, RenderMethod* renderer)
+    {
+        nodes.clear();
+        items.clear();
+        items.reserve(paints.count);
+
+        for (uint32_t i = 0; i < paints.count; ++i) {
+            auto box = PAINT(paints[i])->bounds(renderer);
+            if (box.valid()) items.push({box, i});
+        }
+
+        if (!items.empty()) {
+            nodes.reserve(2 * (items.count / LEAF_SIZE + 1));
+            nodes.next();
+            split(0, 0, items.count);
+        }
+
+        dirty = false;
+    }
+
+    const RenderRegion* bounds() const
+    {
+        if (nodes.empty()) return nullptr;
+        return &nodes.first().box;
+    }
+
+    //collect the children intersecting with the region in the scene order
+    const Array<uint32_t>& cull(const RenderRegion& region)
+    {
+        visibles.clear();
+        visit(region, [&](uint32_t idx) { visibles.push(idx); return false; });
+        std::sort(visibles.begin(), visibles.end());
+        return visibles;
+    }
+
+    //visit the children intersecting with the region, stops once the func returns true.
+    template<typename Func>
+    bool visit(const RenderRegion& region, Func func) const
+    {
+        if (nodes.empty()) return false;
+
+        uint32_t stack[64];
+        uint32_t depth = 0;
+        stack[depth++] = 0;
+
+        while (depth > 0) {
+            auto& node = nodes[stack[--depth]];
+            if (!node.box.intersected(region)) continue;
+            if (node.count > 0) {
+                for (auto item = items.data + node.first; item < items.data + node.first + node.count; ++item) {
+                    if (item->box.intersected(region) && func(item->idx)) return true;
+                }
+            } else {
+                stack[depth++] = node.first + 1;
+                stack[depth++] = node.first;
+            }
+        }
+        return false;
+    }
+
+private:
+    void split(uint32_t nidx, uint32_t begin, uint32_t end)
+    {
+        auto box = items[begin].box;
+        RenderRegion center = {{INT32_MAX, INT32_MAX}, {INT32_MIN, INT32_MIN}};
+        for (auto i = begin; i < end; ++i) {
+            auto& b = items[i].box;
+            box.add(b);
+            center.add({{(b.min.x + b.max.x) / 2, (b.min.y + b.max.y) / 2}, {(b.min.x + b.max.x) / 2, (b.min.y + b.max.y) / 2}});
+        }
+
+        nodes[nidx].box = box;
+
+        if (end - begin <= LEAF_SIZE) {
+            nodes[nidx].first = begin;
+            nodes[nidx].count = end - begin;
+            return;
+        }
+
+        //median split along the longest axis of the centers
+        auto horizontal = (center.max.x - center.min.x) >= (center.max.y - center.min.y);
+        auto mid = begin + (end - begin) / 2;
+        std::nth_element(items.data + begin, items.data + mid, items.data + end, [horizontal](const Item& a, const Item& b) {
+            if (horizontal) return (a.box.min.x + a.box.max.x) < (b.box.min.x + b.box.max.x);
+            return (a.box.min.y + a.box.max.y) < (b.box.min.y + b.box.max.y);
+        });
+
+        auto left = nodes.count;
+        nodes.next();
+        nodes.next();
+        nodes[nidx].first = left;
+        nodes[nidx].count = 0;
+
+        split(left, begin, mid);
+        split(left + 1, mid, end);
+    }
+};
+
+
+//Batched hit-testing context shared along the scene traversal
+struct SceneHitTest
+{
+    const RenderRegion* regions;
+    Paint** hits = nullptr;                                           //topmost hits
+    function<bool(uint32_t idx, Paint* paint, void* data)>* func = nullptr;  //all hits
+    void* data = nullptr;
+    bool stop = false;
+
+    bool resolved(uint32_t idx) const
+    {
+        return hits && hits[idx];
+    }
+
+    void hit(uint32_t idx, Paint* paint)
+    {
+        if (hits) hits[idx] = paint;
+        else if (!(*func)(idx, paint, data)) stop = true;
+    }
+};
+
+
 struct SceneImpl : Scene
 {
     Paint::Impl impl;
-    list<Paint*> paints;     //children list
+    Array<Paint*> paints;    //children list
+    Array<Paint*> retained;  //the previous children while rebuilding them, see rewind()
+    list<Paint*> plist;      //children list for the paints() api, synced on demand
     RenderRegion vport = {};
     Array<RenderEffect*>* effects = nullptr;
+    SceneBvh* bvh = nullptr; //spatial index of the children, valid for large scenes only
     Point fsize;          //fixed scene size
     bool fixed = false;   //true: fixed scene size, false: dynamic size
     bool vdirty = false;
+    bool ldirty = false;  //plist is out of sync
     uint8_t opacity;      //for composition
+    uint32_t cursor = 0;  //the next retained child expected to be pushed again
 
     SceneImpl() : impl(Paint::Impl(this))
     {
@@ -76,8 +225,35 @@ struct SceneImpl : Scene
 
     ~SceneImpl()
     {
+        commit();
         clearPaints();
         resetEffects(false);
+        delete(bvh);
+    }
+
+    const list<Paint*>& children()
+    {
+        if (ldirty) {
+            plist.clear();
+            ARRAY_FOREACH(p, paints) plist.push_back(*p);
+            ldirty = false;
+        }
+        return plist;
+    }
+
+    void invalidate()
+    {
+        ldirty = true;
+        if (bvh) bvh->dirty = true;
+    }
+
+    //returns the up-to-date spatial index if the scene is large enough to take advantage of it.
+    SceneBvh* index(RenderMethod* renderer)
+    {
+        if (paints.count < SceneBvh::THRESHOLD) return nullptr;
+        if (!bvh) bvh = new SceneBvh;
+        if (bvh->dirty) bvh->build(paints, renderer);
+        return bvh;
     }
 
     void size(const Point& size)
@@ -99,8 +275,8 @@ struct SceneImpl : Scene
         if (opacity == 255) return impl.cmpFlag;
 
         //Only shape or picture may not require composition.
-        if (paints.size() == 1) {
-            auto type = paints.front()->type();
+        if (paints.count == 1) {
+            auto type = paints.first()->type();
             if (type == Type::Shape || type == Type::Picture) return impl.cmpFlag;
         }
 
@@ -128,10 +304,13 @@ struct SceneImpl : Scene
         //allow partial rendering?
         auto recover = fixed ? renderer->partial(true) : false;
 
-        for (auto paint : paints) {
-            PAINT(paint)->update(renderer, transform, clips, opacity, flag, false);
+        ARRAY_FOREACH(p, paints) {
+            PAINT((*p))->update(renderer, transform, clips, opacity, flag, false);
         }
 
+        //children regions might be changed
+        if (bvh) bvh->dirty = true;
+
         //recover the condition
         if (fixed) renderer->partial(recover);
 
@@ -172,8 +351,15 @@ struct SceneImpl : Scene
             renderer->beginComposite(cmp, MaskMethod::None, opacity);
         }
 
-        for (auto paint : paints) {
-            ret &= paint->pImpl->render(renderer);
+        //the large scene draws the children within the viewport only
+        if (auto bvh = index(renderer)) {
+            ARRAY_FOREACH(p, bvh->cull(renderer->viewport())) {
+                ret &= paints[*p]->pImpl->render(renderer);
+            }
+        } else {
+            ARRAY_FOREACH(p, paints) {
+                ret &= (*p)->pImpl->render(renderer);
+            }
         }
 
         if (cmp) {
@@ -199,12 +385,17 @@ struct SceneImpl : Scene
 
         //Merge regions
         RenderRegion pRegion = {{INT32_MAX, INT32_MAX}, {0, 0}};
-        for (auto paint : paints) {
-            auto region = paint->pImpl->bounds(renderer);
-            if (region.min.x < pRegion.min.x) pRegion.min.x = region.min.x;
-            if (pRegion.max.x < region.max.x) pRegion.max.x = region.max.x;
-            if (region.min.y < pRegion.min.y) pRegion.min.y = region.min.y;
-            if (pRegion.max.y < region.max.y) pRegion.max.y = region.max.y;
+        if (bvh && !bvh->dirty) {
+            //the root node already has the merged regions
+            if (auto box = bvh->bounds()) pRegion = *box;
+        } else {
+            ARRAY_FOREACH(p, paints) {
+                auto region = (*p)->pImpl->bounds(renderer);
+                if (region.min.x < pRegion.min.x) pRegion.min.x = region.min.x;
+                if (pRegion.max.x < region.max.x) pRegion.max.x = region.max.x;
+                if (region.min.y < pRegion.min.y) pRegion.min.y = region.min.y;
+                if (pRegion.max.y < region.max.y) pRegion.max.y = region.max.y;
+            }
         }
 
         //Extends the render region if post effects require
@@ -232,9 +423,9 @@ struct SceneImpl : Scene
         Point min = {FLT_MAX, FLT_MAX};
         Point max = {-FLT_MAX, -FLT_MAX};
 
-        for (auto paint : paints) {
+        ARRAY_FOREACH(p, paints) {
             Point tmp[4];
-            if (PAINT(paint)->bounds(tmp, obb ? nullptr : &m, false, stroking) != Result::Success) continue;
+            if (PAINT((*p))->bounds(tmp, obb ? nullptr : &m, false, stroking) != Result::Success) continue;
             //Merge regions
             for (int i = 0; i < 4; ++i) {
                 if (tmp[i].x < min.x) min.x = tmp[i].x;
@@ -263,26 +454,114 @@ struct SceneImpl : Scene
         if (!impl.renderer) return false;
 
         if (this->bounds(impl.renderer).intersected(region)) {
-            for (auto paint : paints) {
-                if (PAINT(paint)->intersects(region)) return true;
+            if (auto bvh = index(impl.renderer)) {
+                return bvh->visit(region, [&](uint32_t idx) { return PAINT(paints[idx])->intersects(region); });
+            }
+            ARRAY_FOREACH(p, paints) {
+                if (PAINT((*p))->intersects(region)) return true;
             }
         }
 
         return false;
     }
 
-    Paint* duplicate(Paint* ret)
+    //test the queries(indices of the regions) against the children from the top to the bottom
+    void intersects(SceneHitTest& test, const Array<uint32_t>& queries)
+    {
+        auto probe = [&](Paint* paint, const Array<uint32_t>& candidates) {
+            if (paint->type() == Type::Scene) {
+                if (PAINT(paint)->renderer) SCENE(paint)->intersects(test, candidates);
+                return;
+            }
+            ARRAY_FOREACH(q, candidates) {
+                if (test.stop) return;
+                if (!test.resolved(*q) && PAINT(paint)->intersects(test.regions[*q])) test.hit(*q, paint);
+            }
+        };
+
+        Array<uint32_t> candidates(queries.count);
+
+        //Visit the children only overlapped with the regions using the spatial index
+        if (auto bvh = index(impl.renderer)) {
+            struct Pair { uint32_t child, query; };
+            Array<Pair> pairs;
+            ARRAY_FOREACH(q, queries) {
+                bvh->visit(test.regions[*q], [&](uint32_t idx) { pairs.push({idx, *q}); return false; });
+            }
+            std::sort(pairs.begin(), pairs.end(), [](const Pair& a, const Pair& b) {
+                return (a.child > b.child) || (a.child == b.child && a.query < b.query);
+            });
+            for (auto p = pairs.begin(); p < pairs.end() && !test.stop;) {
+                auto child = p->child;
+                candidates.clear();
+                for (; p < pairs.end() && p->child == child; ++p) {
+                    if (!test.resolved(p->query)) candidates.push(p->query);
+                }
+                if (!candidates.empty()) probe(paints[child], candidates);
+            }
+            return;
+        }
+
+        ARRAY_REVERSE_FOREACH(p, paints) {
+            if (test.stop) return;
+            auto box = PAINT((*p))->bounds(impl.renderer);
+            candidates.clear();
+            ARRAY_FOREACH(q, queries) {
+                if (!test.resolved(*q) && box.intersected(test.regions[*q])) candidates.push(*q);
+            }
+            if (!candidates.empty()) probe(*p, candidates);
+        }
+    }
+
+    Result intersects(SceneHitTest& test, uint32_t cnt)
     {
-        if (ret) TVGERR("RENDERER", "TODO: duplicate()");
+        if (!impl.renderer || paints.empty()) return Result::InsufficientCondition;
+
+        auto box = this->bounds(impl.renderer);
+        Array<uint32_t> queries(cnt);
+        for (uint32_t i = 0; i < cnt; ++i) {
+            auto& region = test.regions[i];
+            if (region.valid() && box.intersected(region)) queries.push(i);
+        }
+        if (!queries.empty()) intersects(test, queries);
+        return Result::Success;
+    }
+
+    //duplicate the children into the ones of the previous duplication in order, so that only the differences are updated
+    void recycle(SceneImpl* dup)
+    {
+        dup->rewind();
+
+        for (uint32_t i = 0; i < paints.count; ++i) {
+            auto src = paints[i];
+            auto prv = (i < dup->retained.count) ? dup->retained[i] : nullptr;
+            if (prv && prv->type() == src->type() && (prv->type() == Type::Shape || prv->type() == Type::Scene)) {
+                dup->insert(PAINT(src)->duplicate(prv), nullptr);
+            } else {
+                dup->insert(src->duplicate(), nullptr);
+            }
+        }
+
+        dup->commit();
+        dup->resetEffects();
+    }
 
-        auto scene = Scene::gen();
+    Paint* duplicate(Paint* ret)
+    {
+        auto scene = ret ? static_cast<Scene*>(ret) : Scene::gen();
         auto dup = SCENE(scene);
 
-        for (auto paint : paints) {
-            auto cdup = paint->duplicate();
-            PAINT(cdup)->parent = scene;
-            cdup->ref();
-            dup->paints.push_back(cdup);
+        if (ret) {
+            recycle(dup);
+        } else {
+            dup->paints.reserve(paints.count);
+            ARRAY_FOREACH(p, paints) {
+                auto cdup = (*p)->duplicate();
+                PAINT(cdup)->parent = scene;
+                cdup->ref();
+                dup->paints.push(cdup);
+            }
+            dup->invalidate();
         }
 
         if (effects) {
@@ -331,28 +610,80 @@ struct SceneImpl : Scene
         auto recover = (fixed && impl.renderer) ? impl.renderer->partial(true) : false;
         auto partialDmg = !(effects || fixed || recover);
 
-        auto itr = paints.begin();
-        while (itr != paints.end()) {
-            auto paint = PAINT((*itr));
+        ARRAY_FOREACH(p, paints) {
+            auto paint = PAINT((*p));
             //when the paint is destroyed damage will be triggered
             if (paint->refCnt > 1 && partialDmg) paint->damage();
             paint->unref();
-            paints.erase(itr++);
         }
+        paints.clear();
+        invalidate();
         if (fixed && impl.renderer) impl.renderer->partial(recover);
         if (effects || fixed) impl.damage(vport);  //redraw scene full region
 
         return Result::Success;
     }
 
+    //start rebuilding the children. The ones pushed again before commit() keep their render data without the relocation,
+    //so that only their own changes are updated.
+    void rewind()
+    {
+        commit();
+        ARRAY_FOREACH(p, paints) PAINT((*p))->unref(false);
+        retained.push(paints);
+        paints.clear();
+        invalidate();
+    }
+
+    //finish rebuilding the children, the ones not pushed again are removed
+    void commit()
+    {
+        ARRAY_FOREACH(p, retained) {
+            if (!*p) continue;
+            auto paint = PAINT((*p));
+            if (paint->parent) continue;  //moved to another scene
+            paint->damage();
+            if (paint->refCnt == 0) delete(*p);
+        }
+        retained.clear();
+        cursor = 0;
+    }
+
+    //take the child back from the previous children, returns false if it's a new one
+    bool retake(Paint* target)
+    {
+        for (auto i = cursor; i < retained.count; ++i) {
+            if (retained[i] != target) continue;
+            retained[i] = nullptr;
+            cursor = i + 1;
+            return true;
+        }
+        //the z-order has been changed
+        for (uint32_t i = 0; i < cursor; ++i) {
+            if (retained[i] != target) continue;
+            retained[i] = nullptr;
+            PAINT(target)->damage();
+            return true;
+        }
+        return false;
+    }
+
     Result remove(Paint* paint)
     {
         if (PAINT(paint)->parent != this) return Result::InsufficientCondition;
-        //when the paint is destroyed damage will be triggered
-        if (PAINT(paint)->refCnt > 1) PAINT(paint)->damage();
-        PAINT(paint)->unref();
-        paints.remove(paint);
-        return Result::Success;
+        ARRAY_FOREACH(p, paints) {
+            if (*p == paint) {
+                //when the paint is destroyed damage will be triggered
+                if (PAINT(paint)->refCnt > 1) PAINT(paint)->damage();
+                PAINT(paint)->unref();
+                memmove(p, p + 1, sizeof(Paint*) * (paints.end() - p - 1));
+                paints.pop();
+                invalidate();
+                return Result::Success;
+            }
+        }
+        //not a child, but a clipper or a mask of the child
+        return Result::InsufficientCondition;
     }
 
     Result insert(Paint* target, Paint* at)
@@ -361,19 +692,26 @@ struct SceneImpl : Scene
         auto timpl = PAINT(target);
         if (timpl->parent) return Result::InsufficientCondition;
 
-        target->ref();
-
-        //Relocated the paint to the current scene space
-        timpl->mark(RenderUpdateFlag::Transform);
-
         if (!at) {
-            paints.push_back(target);
+            paints.push(target);
         } else {
             //OPTIMIZE: Remove searching?
-            auto itr = find_if(paints.begin(), paints.end(),[&at](const Paint* paint){ return at == paint; });
+            auto itr = std::find(paints.begin(), paints.end(), at);
             if (itr == paints.end()) return Result::InvalidArguments;
-            paints.insert(itr, target);
+            auto idx = itr - paints.begin();
+            paints.grow(1);
+            itr = paints.begin() + idx;
+            memmove(itr + 1, itr, sizeof(Paint*) * (paints.end() - itr));
+            *itr = target;
+            ++paints.count;
         }
+
+        target->ref();
+
+        //Relocated the paint to the current scene space
+        if (!retake(target)) timpl->mark(RenderUpdateFlag::Transform);
+
+        invalidate();
         timpl->parent = this;
         if (timpl->clipper) PAINT(timpl->clipper)->parent = this;
         if (timpl->maskData) PAINT(timpl->maskData->target)->parent = this;
@@ -142,6 +142,12 @@ Result Shape::order(bool strokeFirst) noexcept
 }
 
 
+Result Shape::instances(const Matrix* transforms, const uint8_t* opacities, uint32_t cnt) noexcept
+{
+    return SHAPE(this)->instances(transforms, opacities, cnt);
+}
+
+
 Result Shape::strokeWidth(float width) noexcept
 {
     SHAPE(this)->strokeWidth(width);
@@ -240,7 +246,7 @@ Result Shape::trimpath(float begin, float end, bool simultaneous) noexcept
 
 Result Shape::fillRule(FillRule r) noexcept
 {
-    SHAPE(this)->rs.rule = r;
+    SHAPE(this)->fillRule(r);
     return Result::Success;
 }
 
@@ -26,34 +26,71 @@
 #include "tvgCommon.h"
 #include "tvgMath.h"
 #include "tvgPaint.h"
+#include "tvgFill.h"
 
 #define SHAPE(A) static_cast<ShapeImpl*>(A)
 #define CONST_SHAPE(A) static_cast<const ShapeImpl*>(A)
 
 struct ShapeImpl : Shape
 {
+    struct Instance
+    {
+        Matrix m;
+        uint8_t opacity;
+    };
+
     Paint::Impl impl;
     RenderShape rs;
+    Array<Instance> inst;      //the copies drawn with their own transforms
+    Array<RenderData> irds;    //render data of the instances except the first one, which uses impl.rd
     uint8_t opacity;    //for composition
 
+    //the path properties lastly passed to the renderer, to discard the redundant path updates
+    struct {
+        RenderPath path;
+        RenderTrimPath trim;
+        FillRule rule = FillRule::NonZero;
+    } prev;
+
     ShapeImpl() : impl(Paint::Impl(this))
     {
     }
 
+    ~ShapeImpl()
+    {
+        if (impl.renderer) {
+            ARRAY_FOREACH(p, irds) {
+                if (*p) impl.renderer->dispose(*p);
+            }
+        }
+    }
+
     bool render(RenderMethod* renderer)
     {
         if (!impl.rd) return false;
 
-        RenderCompositor* cmp = nullptr;
-
         renderer->blend(impl.blendMethod);
 
+        if (inst.empty()) return render(renderer, impl.rd, bounds(renderer), opacity);
+
+        //each instance is composited individually
+        auto ret = render(renderer, impl.rd, renderer->region(impl.rd), MULTIPLY(opacity, inst[0].opacity));
+        for (uint32_t i = 0; i < irds.count; ++i) {
+            if (!render(renderer, irds[i], renderer->region(irds[i]), MULTIPLY(opacity, inst[i + 1].opacity))) ret = false;
+        }
+        return ret;
+    }
+
+    bool render(RenderMethod* renderer, RenderData rd, const RenderRegion& region, uint8_t opacity)
+    {
+        RenderCompositor* cmp = nullptr;
+
         if (impl.cmpFlag) {
-            cmp = renderer->target(bounds(renderer), renderer->colorSpace(), impl.cmpFlag);
+            cmp = renderer->target(region, renderer->colorSpace(), impl.cmpFlag);
             renderer->beginComposite(cmp, MaskMethod::None, opacity);
         }
 
-        auto ret = renderer->renderShape(impl.rd);
+        auto ret = renderer->renderShape(rd);
         if (cmp) renderer->endComposite(cmp);
         return ret;
     }
@@ -94,31 +131,135 @@ struct ShapeImpl : Shape
         return true;
     }
 
+    //check whether the path is identical to the one lastly passed to the renderer
+    bool unchanged()
+    {
+        auto trim = rs.stroke ? rs.stroke->trim : RenderTrimPath();
+        if (prev.rule != rs.rule || prev.trim.begin != trim.begin || prev.trim.end != trim.end || prev.trim.simultaneous != trim.simultaneous) return false;
+
+        auto& lhs = prev.path;
+        auto& rhs = rs.path;
+
+        if (lhs.shared && lhs.shared == rhs.shared) return true;
+        if (lhs.cmds.count != rhs.cmds.count || lhs.pts.count != rhs.pts.count) return false;
+        if (rhs.cmds.count > 0 && memcmp(lhs.cmds.data, rhs.cmds.data, sizeof(PathCommand) * rhs.cmds.count)) return false;
+        if (rhs.pts.count > 0 && memcmp(lhs.pts.data, rhs.pts.data, sizeof(Point) * rhs.pts.count)) return false;
+
+        //rebuilt with the same data, keep the previous one
+        if (lhs.shared) rhs.share(lhs);
+        return true;
+    }
+
     bool skip(RenderUpdateFlag flag)
     {
         if (flag == RenderUpdateFlag::None) return true;
+        if (flag == RenderUpdateFlag::Path && impl.rd && !impl.maskData && !impl.clipper && unchanged()) return true;
         return false;
     }
 
     bool update(RenderMethod* renderer, const Matrix& transform, Array<RenderData>& clips, uint8_t opacity, RenderUpdateFlag flag, bool clipper)
     {
-        if (needComposition(opacity)) {
-            /* Overriding opacity value. If this scene is half-translucent,
-               It must do intermediate composition with that opacity value. */ 
-            this->opacity = opacity;
-            opacity = 255;
+        if (flag & RenderUpdateFlag::Path) {
+            if (impl.rd && unchanged()) flag = RenderUpdateFlag(flag & ~RenderUpdateFlag::Path);
+            else {
+                prev.path.share(rs.path);
+                prev.trim = rs.stroke ? rs.stroke->trim : RenderTrimPath();
+                prev.rule = rs.rule;
+            }
         }
 
-        impl.rd = renderer->prepare(rs, impl.rd, transform, clips, opacity, flag, clipper);
+        //the instances are meaningless for clipping
+        if (inst.empty() || clipper) {
+            if (needComposition(opacity)) {
+                /* Overriding opacity value. If this scene is half-translucent,
+                   It must do intermediate composition with that opacity value. */ 
+                this->opacity = opacity;
+                opacity = 255;
+            }
+            shrink(renderer, 0);
+            impl.rd = renderer->prepare(rs, impl.rd, transform, clips, opacity, flag, clipper);
+            return true;
+        }
+
+        //the most translucent instance decides the composition
+        uint8_t lowest = 0;
+        ARRAY_FOREACH(p, inst) {
+            if (p->opacity > 0 && (lowest == 0 || p->opacity < lowest)) lowest = p->opacity;
+        }
+
+        this->opacity = 255;
+        auto composition = needComposition(MULTIPLY(opacity, lowest));
+        if (composition) this->opacity = opacity;
+
+        auto alpha = [&](uint8_t opacity2) { return composition ? uint8_t(255) : MULTIPLY(opacity, opacity2); };
+
+        impl.rd = renderer->prepare(rs, impl.rd, transform * inst[0].m, clips, alpha(inst[0].opacity), flag, clipper);
+
+        shrink(renderer, inst.count - 1);
+        while (irds.count < inst.count - 1) irds.push(nullptr);
+
+        for (uint32_t i = 1; i < inst.count; ++i) {
+            auto& rd = irds[i - 1];
+            rd = renderer->prepare(rs, rd, transform * inst[i].m, clips, alpha(inst[i].opacity), rd ? flag : RenderUpdateFlag::All, clipper);
+        }
         return true;
     }
 
+    //dispose the render data of the dropped instances
+    void shrink(RenderMethod* renderer, uint32_t cnt)
+    {
+        while (irds.count > cnt) {
+            if (auto rd = irds.last()) {
+                renderer->damage(rd, renderer->region(rd));
+                renderer->dispose(rd);
+            }
+            irds.pop();
+        }
+    }
+
     RenderRegion bounds(RenderMethod* renderer)
     {
-        return renderer->region(impl.rd);
+        auto ret = renderer->region(impl.rd);
+        ARRAY_FOREACH(p, irds) {
+            auto region = renderer->region(*p);
+            if (region.invalid()) continue;
+            if (ret.valid()) ret.add(region);
+            else ret = region;
+        }
+        return ret;
     }
 
     Result bounds(Point* pt4, Matrix& m, bool obb, bool stroking)
+    {
+        if (inst.empty()) return extent(pt4, m, obb, stroking);
+
+        //union of the instances in the canvas space
+        Point min = {FLT_MAX, FLT_MAX};
+        Point max = {-FLT_MAX, -FLT_MAX};
+
+        ARRAY_FOREACH(p, inst) {
+            auto im = m * p->m;
+            Point pts[4];
+            if (extent(pts, im, true, stroking) != Result::Success) continue;
+            for (int i = 0; i < 4; ++i) {
+                if (pts[i].x < min.x) min.x = pts[i].x;
+                if (pts[i].x > max.x) max.x = pts[i].x;
+                if (pts[i].y < min.y) min.y = pts[i].y;
+                if (pts[i].y > max.y) max.y = pts[i].y;
+            }
+        }
+
+        if (min.x > max.x) return Result::InsufficientCondition;
+
+        pt4[0] = min;
+        pt4[1] = {max.x, min.y};
+        pt4[2] = max;
+        pt4[3] = {min.x, max.y};
+
+        return Result::Success;
+    }
+
+    Result extent(Point* pt4, Matrix& m, bool obb, bool stroking)
     {
         float x, y, w, h;
         if (!rs.path.bounds(obb ? nullptr : &m, &x, &y, &w, &h)) return Result::InsufficientCondition;
@@ -153,16 +294,19 @@ struct ShapeImpl : Shape
 
     void reserveCmd(uint32_t cmdCnt)
     {
+        rs.path.detach();
         rs.path.cmds.reserve(cmdCnt);
     }
 
     void reservePts(uint32_t ptsCnt)
     {
+        rs.path.detach();
         rs.path.pts.reserve(ptsCnt);
     }
 
     void grow(uint32_t cmdCnt, uint32_t ptsCnt)
     {
+        rs.path.detach();
         rs.path.cmds.grow(cmdCnt);
         rs.path.pts.grow(ptsCnt);
     }
@@ -178,6 +322,7 @@ struct ShapeImpl : Shape
     void strokeWidth(float width)
     {
         if (!rs.stroke) rs.stroke = new RenderStroke();
+        if (rs.stroke->width == width) return;
         rs.stroke->width = width;
         impl.mark(RenderUpdateFlag::Stroke);
     }
@@ -211,6 +356,7 @@ struct ShapeImpl : Shape
     void strokeCap(StrokeCap cap)
     {
         if (!rs.stroke) rs.stroke = new RenderStroke();
+        if (rs.stroke->cap == cap) return;
         rs.stroke->cap = cap;
         impl.mark(RenderUpdateFlag::Stroke);
     }
@@ -218,6 +364,7 @@ struct ShapeImpl : Shape
     void strokeJoin(StrokeJoin join)
     {
         if (!rs.stroke) rs.stroke = new RenderStroke();
+        if (rs.stroke->join == join) return;
         rs.stroke->join = join;
         impl.mark(RenderUpdateFlag::Stroke);
     }
@@ -228,6 +375,7 @@ struct ShapeImpl : Shape
         // - A negative value for stroke-miterlimit must be treated as an illegal value.
         if (miterlimit < 0.0f) return Result::InvalidArguments;
         if (!rs.stroke) rs.stroke = new RenderStroke();
+        if (rs.stroke->miterlimit == miterlimit) return Result::Success;
         rs.stroke->miterlimit = miterlimit;
         impl.mark(RenderUpdateFlag::Stroke);
 
@@ -237,7 +385,25 @@ struct ShapeImpl : Shape
     bool intersects(const RenderRegion& region)
     {
         if (!impl.rd || !impl.renderer) return false;
-        return impl.renderer->intersectsShape(impl.rd, region);
+        if (impl.renderer->intersectsShape(impl.rd, region)) return true;
+        ARRAY_FOREACH(p, irds) {
+            if (impl.renderer->intersectsShape(*p, region)) return true;
+        }
+        return false;
+    }
+
+    Result instances(const Matrix* transforms, const uint8_t* opacities, uint32_t cnt)
+    {
+        if (cnt > 0 && !transforms) return Result::InvalidArguments;
+
+        inst.clear();
+        inst.reserve(cnt);
+        for (uint32_t i = 0; i < cnt; ++i) {
+            inst.push({transforms[i], opacities ? opacities[i] : uint8_t(255)});
+        }
+        impl.mark(RenderUpdateFlag::Transform | RenderUpdateFlag::Color);
+
+        return Result::Success;
     }
 
     void strokeFill(uint8_t r, uint8_t g, uint8_t b, uint8_t a)
@@ -249,7 +415,10 @@ struct ShapeImpl : Shape
             impl.mark(RenderUpdateFlag::GradientStroke);
         }
 
-        rs.stroke->color = {r, g, b, a};
+        auto& color = rs.stroke->color;
+        if (r == color.r && g == color.g && b == color.b && a == color.a) return;
+
+        color = {r, g, b, a};
 
         impl.mark(RenderUpdateFlag::Stroke);
     }
@@ -272,8 +441,18 @@ struct ShapeImpl : Shape
     {
         if ((!pattern && cnt > 0) || (pattern && cnt == 0)) return Result::InvalidArguments;
         if (!rs.stroke) rs.stroke = new RenderStroke;
-        //Reset dash
         auto& dash = rs.stroke->dash;
+
+        //the same dash
+        if (dash.count == cnt && dash.offset == offset) {
+            uint32_t i = 0;
+            for (; i < cnt; ++i) {
+                if (dash.pattern[i] != (pattern[i] < 0.0f ? 0.0f : pattern[i])) break;
+            }
+            if (i == cnt) return Result::Success;
+        }
+
+        //Reset dash
         if (dash.count != cnt) {
             tvg::free(dash.pattern);
             dash.pattern = nullptr;
@@ -302,6 +481,7 @@ struct ShapeImpl : Shape
     void strokeFirst(bool first)
     {
         if (!rs.stroke) rs.stroke = new RenderStroke();
+        if (rs.stroke->first == first) return;
         rs.stroke->first = first;
         impl.mark(RenderUpdateFlag::Stroke);
     }
@@ -331,10 +511,17 @@ struct ShapeImpl : Shape
         impl.mark(RenderUpdateFlag::Color);
     }
 
+    void fillRule(FillRule rule)
+    {
+        if (rs.rule == rule) return;
+        rs.rule = rule;
+        impl.mark(RenderUpdateFlag::Path);
+    }
+
     void resetPath()
     {
-        rs.path.cmds.clear();
-        rs.path.pts.clear();
+        rs.path.clear();
+        rs.glyphs.clear();
         impl.mark(RenderUpdateFlag::Path);
     }
 
@@ -354,6 +541,7 @@ struct ShapeImpl : Shape
         auto rxKappa = rx * PATH_KAPPA;
         auto ryKappa = ry * PATH_KAPPA;
 
+        rs.path.detach();
         rs.path.cmds.grow(6);
         auto cmds = rs.path.cmds.end();
 
@@ -385,6 +573,8 @@ struct ShapeImpl : Shape
 
     void appendRect(float x, float y, float w, float h, float rx, float ry, bool cw)
     {
+        rs.path.detach();
+
         //sharp rect
         if (tvg::zero(rx) && tvg::zero(ry)) {
             rs.path.cmds.grow(5);
@@ -458,36 +648,84 @@ struct ShapeImpl : Shape
         impl.mark(RenderUpdateFlag::Path);
     }
 
+    //the update flags required to turn the lhs stroke into the rhs one
+    static RenderUpdateFlag diff(const RenderStroke& lhs, const RenderStroke& rhs)
+    {
+        auto flag = RenderUpdateFlag::None;
+
+        if (!equal(lhs.fill, rhs.fill)) flag |= (RenderUpdateFlag::Stroke | RenderUpdateFlag::GradientStroke);
+
+        if (lhs.width != rhs.width || memcmp(&lhs.color, &rhs.color, sizeof(RenderColor)) || lhs.miterlimit != rhs.miterlimit ||
+            lhs.cap != rhs.cap || lhs.join != rhs.join || lhs.first != rhs.first || lhs.dash.count != rhs.dash.count || lhs.dash.offset != rhs.dash.offset ||
+            (rhs.dash.count > 0 && memcmp(lhs.dash.pattern, rhs.dash.pattern, sizeof(float) * rhs.dash.count))) {
+            flag |= RenderUpdateFlag::Stroke;
+        }
+
+        if (lhs.trim.begin != rhs.trim.begin || lhs.trim.end != rhs.trim.end || lhs.trim.simultaneous != rhs.trim.simultaneous) {
+            flag |= RenderUpdateFlag::Path;
+        }
+
+        return flag;
+    }
+
     Paint* duplicate(Paint* ret)
     {
         auto shape = static_cast<Shape*>(ret);
+
+        //the recycled one is marked only by the changes, so that it could skip the redundant updates
         if (shape) shape->reset();
-        else shape = Shape::gen();
+        else {
+            shape = Shape::gen();
+            PAINT(shape)->mark(RenderUpdateFlag::All);
+        }
 
         auto dup = SHAPE(shape);
-        delete(dup->rs.fill);
 
         //Default Properties
-        dup->impl.mark(RenderUpdateFlag::All);
-        dup->rs.rule = rs.rule;
-        dup->rs.color = rs.color;
+        if (dup->rs.rule != rs.rule) {
+            dup->rs.rule = rs.rule;
+            dup->impl.mark(RenderUpdateFlag::Path);
+        }
 
-        //Path
-        dup->rs.path.cmds.push(rs.path.cmds);
-        dup->rs.path.pts.push(rs.path.pts);
+        if (memcmp(&dup->rs.color, &rs.color, sizeof(RenderColor))) {
+            dup->rs.color = rs.color;
+            dup->impl.mark(RenderUpdateFlag::Color);
+        }
+
+        //Path, the data is copied on write
+        dup->rs.path.share(rs.path);
+
+        //Instances
+        auto same = (dup->inst.count == inst.count);
+        for (uint32_t i = 0; same && i < inst.count; ++i) {
+            same = (dup->inst[i].opacity == inst[i].opacity && !memcmp(&dup->inst[i].m, &inst[i].m, sizeof(Matrix)));
+        }
+        if (!same) {
+            dup->inst = inst;
+            dup->impl.mark(RenderUpdateFlag::Transform | RenderUpdateFlag::Color);
+        }
 
         //Stroke
         if (rs.stroke) {
-            if (!dup->rs.stroke) dup->rs.stroke = new RenderStroke;
-            *dup->rs.stroke = *rs.stroke;
-        } else {
+            auto flag = RenderUpdateFlag::Stroke | RenderUpdateFlag::GradientStroke | RenderUpdateFlag::Path;
+            if (dup->rs.stroke) flag = diff(*dup->rs.stroke, *rs.stroke);
+            else dup->rs.stroke = new RenderStroke;
+            if (flag != RenderUpdateFlag::None) {
+                *dup->rs.stroke = *rs.stroke;
+                dup->impl.mark(flag);
+            }
+        } else if (dup->rs.stroke) {
             delete(dup->rs.stroke);
             dup->rs.stroke = nullptr;
+            dup->impl.mark(RenderUpdateFlag::Stroke | RenderUpdateFlag::GradientStroke | RenderUpdateFlag::Path);
         }
 
         //Fill
-        if (rs.fill) dup->rs.fill = rs.fill->duplicate();
-        else dup->rs.fill = nullptr;
+        if (!equal(dup->rs.fill, rs.fill)) {
+            delete(dup->rs.fill);
+            dup->rs.fill = rs.fill ? rs.fill->duplicate() : nullptr;
+            dup->impl.mark(RenderUpdateFlag::Gradient);
+        }
 
         return shape;
     }
@@ -495,17 +733,31 @@ struct ShapeImpl : Shape
     void reset()
     {
         PAINT(this)->reset();
-        rs.path.cmds.clear();
-        rs.path.pts.clear();
+        resetPath();
+
+        if (!inst.empty()) {
+            inst.clear();
+            impl.mark(RenderUpdateFlag::Transform | RenderUpdateFlag::Color);
+        }
+
+        if (rs.color.a != 0) {
+            rs.color.a = 0;
+            impl.mark(RenderUpdateFlag::Color);
+        }
 
-        rs.color.a = 0;
         rs.rule = FillRule::NonZero;
 
-        delete(rs.stroke);
-        rs.stroke = nullptr;
+        if (rs.stroke) {
+            delete(rs.stroke);
+            rs.stroke = nullptr;
+            impl.mark(RenderUpdateFlag::Stroke | RenderUpdateFlag::GradientStroke);
+        }
 
-        delete(rs.fill);
-        rs.fill = nullptr;
+        if (rs.fill) {
+            delete(rs.fill);
+            rs.fill = nullptr;
+            impl.mark(RenderUpdateFlag::Gradient);
+        }
     }
 
     Iterator* iterator()
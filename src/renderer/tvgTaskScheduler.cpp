@@ -33,6 +33,8 @@ namespace tvg {
 
 #ifdef THORVG_THREAD_SUPPORT
 
+static thread_local unsigned _index = 0;   //task id of this thread, 0 for the non-worker threads
+
 struct TaskQueue {
     Inlist<Task>             taskDeque;
     mutex                    mtx;
@@ -44,6 +46,7 @@ struct TaskQueue {
         unique_lock<mutex> lock{mtx, try_to_lock};
         if (!lock || taskDeque.empty()) return false;
         *task = taskDeque.front();
+        (*task)->queued = false;
         return true;
     }
 
@@ -52,6 +55,7 @@ struct TaskQueue {
         {
             unique_lock<mutex> lock{mtx, try_to_lock};
             if (!lock) return false;
+            task->queued = true;
             taskDeque.back(task);
         }
         ready.notify_one();
@@ -78,6 +82,7 @@ struct TaskQueue {
         if (taskDeque.empty()) return false;
 
         *task = taskDeque.front();
+        (*task)->queued = false;
         return true;
     }
 
@@ -85,10 +90,20 @@ struct TaskQueue {
     {
         {
             lock_guard<mutex> lock{mtx};
+            task->queued = true;
             taskDeque.back(task);
         }
         ready.notify_one();
     }
+
+    bool revoke(Task* task)
+    {
+        lock_guard<mutex> lock{mtx};
+        if (!task->queued) return false;
+        taskDeque.remove(task);
+        task->queued = false;
+        return true;
+    }
 };
 
 
@@ -129,6 +144,7 @@ struct TaskSchedulerImpl
     void run(unsigned i)
     {
         Task* task;
+        _index = i + 1;
 
         //Thread Loop
         while (true) {
@@ -152,15 +168,22 @@ struct TaskSchedulerImpl
             task->prepare();
             auto i = idx++;
             for (uint32_t n = 0; n < threads.count; ++n) {
-                if (taskQueues[(i + n) % threads.count]->tryPush(task)) return;
+                task->queue = (i + n) % threads.count;
+                if (taskQueues[task->queue]->tryPush(task)) return;
             }
-            taskQueues[i % threads.count]->push(task);
+            task->queue = i % threads.count;
+            taskQueues[task->queue]->push(task);
         //Sync
         } else {
             task->run(0);
         }
     }
 
+    bool revoke(Task* task)
+    {
+        return taskQueues[task->queue]->revoke(task);
+    }
+
     uint32_t threadCnt()
     {
         return threads.count;
@@ -173,6 +196,7 @@ struct TaskSchedulerImpl
 {
     TaskSchedulerImpl(TVG_UNUSED uint32_t threadCnt) {}
     void request(Task* task) { task->run(0); }
+    bool revoke(TVG_UNUSED Task* task) { return false; }
     uint32_t threadCnt() { return 0; }
 };
 
@@ -188,6 +212,33 @@ struct TaskSchedulerImpl
 static TaskSchedulerImpl* _inst = nullptr;
 static ThreadID _tid;   //dominant thread id
 
+
+#ifdef THORVG_THREAD_SUPPORT
+
+void Task::done()
+{
+    if (!pending) return;
+
+    //nobody started it yet, run it here rather than waiting for the threads that might be waiting for this one.
+    if (TaskScheduler::revoke(this)) {
+        run(TaskScheduler::index());
+        pending = false;
+        {
+            lock_guard<mutex> lock(mtx);
+            ready = true;
+        }
+        //the others might be waiting for this one as well
+        cv.notify_all();
+        return;
+    }
+
+    unique_lock<mutex> lock(mtx);
+    while (!ready) cv.wait(lock);
+    pending = false;
+}
+
+#endif
+
 void TaskScheduler::init(uint32_t threads)
 {
     if (_inst) return;
@@ -221,6 +272,22 @@ bool TaskScheduler::onthread()
 }
 
 
+bool TaskScheduler::revoke(Task* task)
+{
+    return _inst ? _inst->revoke(task) : false;
+}
+
+
+unsigned TaskScheduler::index()
+{
+#ifdef THORVG_THREAD_SUPPORT
+    return _index;
+#else
+    return 0;
+#endif
+}
+
+
 ThreadID TaskScheduler::tid()
 {
 #ifdef THORVG_THREAD_SUPPORT
@@ -45,22 +45,17 @@ struct Task
 private:
     mutex                   mtx;
     condition_variable      cv;
+    uint32_t                queue = 0;        //index of the queue holding this task
     bool                    ready = true;
     bool                    pending = false;
+    bool                    queued = false;   //not taken by any thread yet
 
 public:
     INLIST_ITEM(Task);
 
     virtual ~Task() = default;
 
-    void done()
-    {
-        if (!pending) return;
-
-        unique_lock<mutex> lock(mtx);
-        while (!ready) cv.wait(lock);
-        pending = false;
-    }
+    void done();
 
 protected:
     virtual void run(unsigned tid) = 0;
@@ -72,7 +67,7 @@ private:
 
         lock_guard<mutex> lock(mtx);
         ready = true;
-        cv.notify_one();
+        cv.notify_all();
     }
 
     void prepare()
@@ -81,6 +76,7 @@ private:
         pending = true;
     }
 
+    friend struct TaskQueue;
     friend struct TaskSchedulerImpl;
 };
 
@@ -114,6 +110,8 @@ struct TaskScheduler
     static void request(Task* task);
     static bool onthread();  //figure out whether on worker thread or not
     static ThreadID tid();
+    static bool revoke(Task* task);  //take the task back if no thread started it yet
+    static unsigned index();  //task id of the current thread
 };
 
 }  //namespace
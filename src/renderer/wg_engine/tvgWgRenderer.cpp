@@ -305,6 +305,13 @@ bool WgRenderer::clear()
 }
 
 
+bool WgRenderer::wait()
+{
+    //the render data are prepared in place, but the drawing might read the paints any time
+    return true;
+}
+
+
 bool WgRenderer::sync()
 {
     if (mContext.invalid()) return false;
@@ -27,6 +27,8 @@
 #endif
 #include <fstream>
 #include <cstring>
+#include <cstdio>
+#include <string>
 #include "catch.hpp"
 
 using namespace tvg;
@@ -96,6 +98,75 @@ TEST_CASE("Lottie Slot 2", "[tvgLottie]")
     REQUIRE(Initializer::term() == Result::Success);
 }
 
+TEST_CASE("Lottie Slot Update", "[tvgLottie]")
+{
+#ifdef THORVG_SW_RASTER_SUPPORT
+    static uint32_t buffer[100*100];
+    static uint32_t buffer2[100*100];
+    static uint32_t origin[100*100];
+
+    REQUIRE(Initializer::init() == Result::Success);
+    {
+        auto test = [&](const char* path, const char* slotJson) {
+            auto animation = unique_ptr<LottieAnimation>(LottieAnimation::gen());
+            auto picture = animation->picture();
+            REQUIRE(picture->load(path) == Result::Success);
+            REQUIRE(picture->size(100, 100) == Result::Success);
+
+            auto canvas = unique_ptr<SwCanvas>(SwCanvas::gen());
+            REQUIRE(canvas->target(buffer, 100, 100, 100, ColorSpace::ARGB8888) == Result::Success);
+            REQUIRE(canvas->push(picture) == Result::Success);
+
+            auto draw = [](SwCanvas* canvas) {
+                REQUIRE(canvas->update() == Result::Success);
+                REQUIRE(canvas->draw(true) == Result::Success);
+                REQUIRE(canvas->sync() == Result::Success);
+            };
+
+            REQUIRE(animation->frame(10) == Result::Success);
+            draw(canvas.get());
+            memcpy(origin, buffer, sizeof(buffer));
+
+            //the reference overridden before drawn
+            auto animation2 = unique_ptr<LottieAnimation>(LottieAnimation::gen());
+            auto picture2 = animation2->picture();
+            REQUIRE(picture2->load(path) == Result::Success);
+            REQUIRE(picture2->size(100, 100) == Result::Success);
+            REQUIRE(animation2->override(slotJson) == Result::Success);
+            REQUIRE(animation2->frame(10) == Result::Success);
+
+            auto canvas2 = unique_ptr<SwCanvas>(SwCanvas::gen());
+            REQUIRE(canvas2->target(buffer2, 100, 100, 100, ColorSpace::ARGB8888) == Result::Success);
+            REQUIRE(canvas2->push(picture2) == Result::Success);
+            draw(canvas2.get());
+
+            //the batch of the slots applied to the current frame without marking the picture
+            REQUIRE(animation->override(slotJson) == Result::Success);
+            draw(canvas.get());
+            REQUIRE(memcmp(buffer, buffer2, sizeof(buffer)) == 0);
+            REQUIRE(memcmp(buffer, origin, sizeof(buffer)) != 0);
+
+            //the contents built again keep the overridden properties on the other frames
+            REQUIRE(animation->frame(20) == Result::Success);
+            REQUIRE(animation2->frame(20) == Result::Success);
+            draw(canvas.get());
+            draw(canvas2.get());
+            REQUIRE(memcmp(buffer, buffer2, sizeof(buffer)) == 0);
+
+            //revert
+            REQUIRE(animation->override(nullptr) == Result::Success);
+            REQUIRE(animation->frame(10) == Result::Success);
+            draw(canvas.get());
+            REQUIRE(memcmp(buffer, origin, sizeof(buffer)) == 0);
+        };
+
+        test(TEST_DIR"/lottieslot.json", R"({"gradient_fill":{"p":{"p":2,"k":{"a":0,"k":[0,0.1,0.1,0.2,1,1,0.1,0.2,0.1,1]}}}})");
+        test(TEST_DIR"/lottieslotkeyframe.json", R"({"lottie-icon-outline":{"p":{"a":0,"k":[1,1,0]}},"lottie-icon-solid":{"p":{"a":0,"k":[0,0,1]}}})");
+    }
+    REQUIRE(Initializer::term() == Result::Success);
+#endif
+}
+
 TEST_CASE("Lottie Marker", "[tvgLottie]")
 {
     REQUIRE(Initializer::init() == Result::Success);
@@ -129,4 +200,590 @@ TEST_CASE("Lottie Marker", "[tvgLottie]")
     REQUIRE(Initializer::term() == Result::Success);
 }
 
+TEST_CASE("Lottie Frame Update", "[tvgLottie]")
+{
+#ifdef THORVG_SW_RASTER_SUPPORT
+    REQUIRE(Initializer::init() == Result::Success);
+    {
+        //the scene tree of the previous frame is rebuilt in place
+        auto animation = unique_ptr<LottieAnimation>(LottieAnimation::gen());
+        auto picture = animation->picture();
+        REQUIRE(picture->load(TEST_DIR"/test.json") == Result::Success);
+        REQUIRE(picture->size(100, 100) == Result::Success);
+
+        //no clear, only the changed regions are redrawn
+        auto canvas = unique_ptr<SwCanvas>(SwCanvas::gen());
+        uint32_t buffer[100*100] = {};
+        REQUIRE(canvas->target(buffer, 100, 100, 100, ColorSpace::ARGB8888) == Result::Success);
+        REQUIRE(canvas->push(picture) == Result::Success);
+
+        auto totalFrame = animation->totalFrame();
+
+        for (auto frame = 1.0f; frame < totalFrame; frame += 1.0f) {
+            REQUIRE(animation->frame(frame) == Result::Success);
+            REQUIRE(canvas->update() == Result::Success);
+            REQUIRE(canvas->draw(false) == Result::Success);
+            REQUIRE(canvas->sync() == Result::Success);
+
+            if (int(frame) % 10) continue;
+
+            //must be identical to the frame built from scratch
+            auto animation2 = unique_ptr<LottieAnimation>(LottieAnimation::gen());
+            auto picture2 = animation2->picture();
+            REQUIRE(picture2->load(TEST_DIR"/test.json") == Result::Success);
+            REQUIRE(picture2->size(100, 100) == Result::Success);
+            REQUIRE(animation2->frame(frame) == Result::Success);
+
+            auto canvas2 = unique_ptr<SwCanvas>(SwCanvas::gen());
+            uint32_t buffer2[100*100];
+            REQUIRE(canvas2->target(buffer2, 100, 100, 100, ColorSpace::ARGB8888) == Result::Success);
+            REQUIRE(canvas2->push(picture2) == Result::Success);
+            REQUIRE(canvas2->draw(true) == Result::Success);
+            REQUIRE(canvas2->sync() == Result::Success);
+
+            REQUIRE(memcmp(buffer, buffer2, sizeof(buffer)) == 0);
+        }
+    }
+    REQUIRE(Initializer::term() == Result::Success);
+#endif
+}
+
+TEST_CASE("Lottie Expressions with Threads", "[tvgLottie]")
+{
+#ifdef THORVG_SW_RASTER_SUPPORT
+    auto render = [](uint32_t* buffer, unique_ptr<LottieAnimation>* animations, int cnt) {
+        unique_ptr<SwCanvas> canvases[3];
+        for (int i = 0; i < cnt; ++i) {
+            animations[i] = unique_ptr<LottieAnimation>(LottieAnimation::gen());
+            auto picture = animations[i]->picture();
+            REQUIRE(picture->load(TEST_DIR"/test6.json") == Result::Success);
+            REQUIRE(picture->size(100, 100) == Result::Success);
+            canvases[i] = unique_ptr<SwCanvas>(SwCanvas::gen());
+            REQUIRE(canvases[i]->target(buffer + i * 100 * 100, 100, 100, 100, ColorSpace::ARGB8888) == Result::Success);
+            REQUIRE(canvases[i]->push(picture) == Result::Success);
+        }
+        //the loaders are updated concurrently
+        for (int i = 0; i < cnt; ++i) REQUIRE(animations[i]->frame(animations[i]->totalFrame() * 0.5f) == Result::Success);
+        for (int i = 0; i < cnt; ++i) {
+            REQUIRE(canvases[i]->draw(true) == Result::Success);
+            REQUIRE(canvases[i]->sync() == Result::Success);
+        }
+    };
+
+    static uint32_t expected[100*100];
+    static uint32_t buffer[3*100*100];
+
+    REQUIRE(Initializer::init() == Result::Success);
+    {
+        unique_ptr<LottieAnimation> animations[1];
+        render(expected, animations, 1);
+    }
+    REQUIRE(Initializer::term() == Result::Success);
+
+    //the expressions are evaluated on the worker threads as well
+    REQUIRE(Initializer::init(2) == Result::Success);
+    {
+        unique_ptr<LottieAnimation> animations[3];
+        render(buffer, animations, 3);
+        for (int i = 0; i < 3; ++i) {
+            REQUIRE(memcmp(expected, buffer + i * 100 * 100, sizeof(expected)) == 0);
+        }
+    }
+    REQUIRE(Initializer::term() == Result::Success);
+
+    //the canvases are released while the loaders are rebuilding the scenes
+    REQUIRE(Initializer::init(2) == Result::Success);
+    for (int n = 0; n < 10; ++n) {
+        unique_ptr<LottieAnimation> animations[3];
+        unique_ptr<SwCanvas> canvases[3];
+        for (int i = 0; i < 3; ++i) {
+            animations[i] = unique_ptr<LottieAnimation>(LottieAnimation::gen());
+            auto picture = animations[i]->picture();
+            REQUIRE(picture->load(TEST_DIR"/test6.json") == Result::Success);
+            REQUIRE(picture->size(100, 100) == Result::Success);
+            canvases[i] = unique_ptr<SwCanvas>(SwCanvas::gen());
+            REQUIRE(canvases[i]->target(buffer + i * 100 * 100, 100, 100, 100, ColorSpace::ARGB8888) == Result::Success);
+            REQUIRE(canvases[i]->push(picture) == Result::Success);
+            REQUIRE(canvases[i]->draw(true) == Result::Success);
+            REQUIRE(canvases[i]->sync() == Result::Success);
+        }
+        for (int i = 0; i < 3; ++i) {
+            REQUIRE(animations[i]->frame(animations[i]->totalFrame() * (0.05f + 0.09f * n)) == Result::Success);
+            canvases[i].reset();
+        }
+    }
+    REQUIRE(Initializer::term() == Result::Success);
+#endif
+}
+
+TEST_CASE("Lottie Expressions with Many Layers", "[tvgLottie]")
+{
+#ifdef THORVG_SW_RASTER_SUPPORT
+    //far more expressions than the engine retains at once
+    string json = R"({"v":"5.7.0","fr":30,"ip":0,"op":60,"w":100,"h":100,"layers":[)";
+    for (int i = 0; i < 200; ++i) {
+        auto k = to_string(i);
+        if (i > 0) json += ",";
+        json += R"({"ty":4,"ind":)" + k + R"(,"ip":0,"op":60,"st":0,"ks":{)"
+                R"("o":{"a":0,"k":100,"x":"var $bm_rt;\n$bm_rt = clamp(value - )" + k + R"( % 7, 0, 100);"},)"
+                R"("r":{"a":0,"k":0,"x":"var $bm_rt;\n$bm_rt = time * )" + k + R"(;"},)"
+                R"("p":{"a":0,"k":[50,50,0]},"a":{"a":0,"k":[0,0,0]},"s":{"a":0,"k":[100,100,100]}},)"
+                R"("shapes":[{"ty":"rc","s":{"a":0,"k":[20,20],"x":"var $bm_rt;\n$bm_rt = add(value, [)" + k + R"( % 5, 0]);"},"p":{"a":0,"k":[0,0]},"r":{"a":0,"k":0}},)"
+                R"({"ty":"fl","c":{"a":0,"k":[1,0,0,1]},"o":{"a":0,"k":100,"x":"var $bm_rt;\n$bm_rt = thisLayer.index > 0 ? value : 0;"}}]})";
+    }
+    json += "]}";
+
+    static uint32_t expected[100*100];
+    static uint32_t buffer[100*100];
+
+    REQUIRE(Initializer::init() == Result::Success);
+    {
+        auto animation = unique_ptr<Animation>(Animation::gen());
+        auto picture = animation->picture();
+        REQUIRE(picture->load(json.data(), json.size(), "lot", "", true) == Result::Success);
+
+        auto canvas = unique_ptr<SwCanvas>(SwCanvas::gen());
+        REQUIRE(canvas->target(buffer, 100, 100, 100, ColorSpace::ARGB8888) == Result::Success);
+        REQUIRE(canvas->push(picture) == Result::Success);
+
+        auto render = [&](float frameNo) {
+            REQUIRE(animation->frame(frameNo) == Result::Success);
+            REQUIRE(canvas->update() == Result::Success);
+            REQUIRE(canvas->draw(true) == Result::Success);
+            REQUIRE(canvas->sync() == Result::Success);
+        };
+
+        render(10.0f);
+        REQUIRE(buffer[50 * 100 + 50] != 0);
+        memcpy(expected, buffer, sizeof(expected));
+
+        //the evicted ones are compiled again with the same results
+        render(20.0f);
+        render(10.0f);
+        REQUIRE(memcmp(expected, buffer, sizeof(expected)) == 0);
+    }
+    REQUIRE(Initializer::term() == Result::Success);
+#endif
+}
+
+TEST_CASE("Lottie Matte Clipper", "[tvgLottie]")
+{
+#ifdef THORVG_SW_RASTER_SUPPORT
+    static uint32_t expected[100*100];
+    static uint32_t buffer[100*100];
+
+    auto rect = [](int x, int y, int w, int h) {
+        return R"({"ty":"gr","it":[{"ty":"rc","s":{"a":0,"k":[)" + to_string(w) + "," + to_string(h) + R"(]},"p":{"a":0,"k":[)" + to_string(x) + "," + to_string(y) + R"(]},"r":{"a":0,"k":0}},)"
+               R"({"ty":"fl","c":{"a":0,"k":[1,0,0,1]},"o":{"a":0,"k":100}},{"ty":"tr","p":{"a":0,"k":[0,0]},"a":{"a":0,"k":[0,0]},"s":{"a":0,"k":[100,100]},"r":{"a":0,"k":0},"o":{"a":0,"k":100}}]})";
+    };
+
+    auto mask = [](const char* mode, int x, int y, int w, int h) {
+        auto l = to_string(x), t = to_string(y), r = to_string(x + w), b = to_string(y + h);
+        return string(R"({"mode":")") + mode + R"(","o":{"a":0,"k":100},"pt":{"a":0,"k":{"c":true,"i":[[0,0],[0,0],[0,0],[0,0]],"o":[[0,0],[0,0],[0,0],[0,0]],"v":[[)" +
+               l + "," + t + "],[" + r + "," + t + "],[" + r + "," + b + "],[" + l + "," + b + R"(]]}}})";
+    };
+
+    auto layer = [](int ind, const string& extra, const string& shapes) {
+        return R"({"ty":4,"ind":)" + to_string(ind) + R"(,"ip":0,"op":10,"st":0,)" + extra +
+               R"("ks":{"o":{"a":0,"k":100},"r":{"a":0,"k":0},"p":{"a":0,"k":[10,10,0]},"a":{"a":0,"k":[0,0,0]},"s":{"a":0,"k":[100,100,100]}},"shapes":[)" + shapes + "]}";
+    };
+
+    auto lottie = [](const string& layers) {
+        return R"({"v":"5.7.0","fr":30,"ip":0,"op":10,"w":100,"h":100,"layers":[)" + layers + "]}";
+    };
+
+    REQUIRE(Initializer::init() == Result::Success);
+    {
+        auto render = [&](const string& json) {
+            auto animation = unique_ptr<Animation>(Animation::gen());
+            auto picture = animation->picture();
+            REQUIRE(picture->load(json.data(), json.size(), "lot", "", true) == Result::Success);
+
+            auto canvas = unique_ptr<SwCanvas>(SwCanvas::gen());
+            REQUIRE(canvas->target(buffer, 100, 100, 100, ColorSpace::ARGB8888) == Result::Success);
+            REQUIRE(canvas->push(picture) == Result::Success);
+            REQUIRE(animation->frame(1.0f) == Result::Success);
+            REQUIRE(canvas->draw(true) == Result::Success);
+            REQUIRE(canvas->sync() == Result::Success);
+        };
+
+        //the alpha matte of a single opaque shape is replaced with a clipper
+        render(lottie(layer(1, R"("td":1,)", rect(30, 30, 40, 40)) + "," + layer(2, R"("tt":1,)", rect(50, 50, 60, 60))));
+        REQUIRE(buffer[40 * 100 + 40] != 0);
+        REQUIRE(buffer[20 * 100 + 20] == 0);
+        memcpy(expected, buffer, sizeof(expected));
+
+        //an overlapped shape in the matte source keeps it composited with the same alpha
+        render(lottie(layer(1, R"("td":1,)", rect(30, 30, 40, 40) + "," + rect(30, 30, 20, 20)) + "," + layer(2, R"("tt":1,)", rect(50, 50, 60, 60))));
+        REQUIRE(memcmp(expected, buffer, sizeof(expected)) == 0);
+
+        //the intersecting masks are replaced with the nested clippers
+        auto masks = string(R"("hasMask":true,"masksProperties":[)") + mask("a", 0, 0, 60, 60) + "," + mask("i", 20, 20, 60, 60);
+        render(lottie(layer(1, masks + "],", rect(40, 40, 80, 80))));
+        REQUIRE(buffer[50 * 100 + 50] != 0);
+        REQUIRE(buffer[20 * 100 + 20] == 0);
+        REQUIRE(buffer[80 * 100 + 80] == 0);
+        memcpy(expected, buffer, sizeof(expected));
+
+        //an additional mask inside the intersection keeps the chain composited with the same area
+        render(lottie(layer(1, masks + "," + mask("a", 30, 30, 20, 20) + "],", rect(40, 40, 80, 80))));
+        REQUIRE(memcmp(expected, buffer, sizeof(expected)) == 0);
+    }
+    REQUIRE(Initializer::term() == Result::Success);
+#endif
+}
+
+TEST_CASE("Lottie Frame Batch", "[tvgLottie]")
+{
+#ifdef THORVG_SW_RASTER_SUPPORT
+    //a sprite sheet of 7 frames in a row
+    static uint32_t sheet[7*100*100];
+    static uint32_t buffer[100*100];
+
+    REQUIRE(Initializer::init(3) == Result::Success);
+    {
+        auto animation = unique_ptr<LottieAnimation>(LottieAnimation::gen());
+        auto picture = animation->picture();
+        REQUIRE(picture->load(TEST_DIR"/test.json") == Result::Success);
+        REQUIRE(picture->size(100, 100) == Result::Success);
+        REQUIRE(animation->frame(2.0f) == Result::Success);
+
+        uint32_t* cells[7];
+        for (int i = 0; i < 7; ++i) cells[i] = sheet + i * 100;
+
+        REQUIRE(animation->render(nullptr, 7, 700, 100, 100, ColorSpace::ARGB8888, 1.0f, 3.0f) == Result::InvalidArguments);
+        REQUIRE(animation->render(cells, 7, 50, 100, 100, ColorSpace::ARGB8888, 1.0f, 3.0f) == Result::InvalidArguments);
+        REQUIRE(animation->render(cells, 7, 700, 100, 100, ColorSpace::ARGB8888, 1.0f, 3.0f) == Result::Success);
+
+        //the animation itself stays intact
+        REQUIRE(animation->curFrame() == 2.0f);
+
+        //each cell is identical to the frame drawn by the animation
+        auto canvas = unique_ptr<SwCanvas>(SwCanvas::gen());
+        REQUIRE(canvas->target(buffer, 100, 100, 100, ColorSpace::ARGB8888) == Result::Success);
+        REQUIRE(canvas->push(picture) == Result::Success);
+
+        for (int i = 0; i < 7; ++i) {
+            REQUIRE(animation->frame(1.0f + 3.0f * i) == Result::Success);
+            REQUIRE(canvas->update() == Result::Success);
+            REQUIRE(canvas->draw(true) == Result::Success);
+            REQUIRE(canvas->sync() == Result::Success);
+            auto differs = 0;
+            for (int y = 0; y < 100; ++y) {
+                if (memcmp(buffer + y * 100, sheet + y * 700 + i * 100, 100 * sizeof(uint32_t))) ++differs;
+            }
+            REQUIRE(differs == 0);
+        }
+
+        //the expressions have the states per animation
+        auto animation2 = unique_ptr<LottieAnimation>(LottieAnimation::gen());
+        REQUIRE(animation2->picture()->load(TEST_DIR"/test6.json") == Result::Success);
+        REQUIRE(animation2->render(cells, 7, 700, 100, 100, ColorSpace::ARGB8888, 0.0f) == Result::NonSupport);
+    }
+    REQUIRE(Initializer::term() == Result::Success);
+#endif
+}
+
+TEST_CASE("Lottie Frame Cache", "[tvgLottie]")
+{
+#ifdef THORVG_SW_RASTER_SUPPORT
+    static uint32_t buffer[100*100];
+    static uint32_t buffer2[100*100];
+
+    REQUIRE(Initializer::init() == Result::Success);
+    {
+        auto animation = unique_ptr<LottieAnimation>(LottieAnimation::gen());
+        REQUIRE(animation->cache(1024 * 1024) == Result::InsufficientCondition);
+
+        auto picture = animation->picture();
+        REQUIRE(picture->load(TEST_DIR"/test.json") == Result::Success);
+        REQUIRE(picture->size(100, 100) == Result::Success);
+
+        //the reference without the cache
+        auto animation2 = unique_ptr<LottieAnimation>(LottieAnimation::gen());
+        auto picture2 = animation2->picture();
+        REQUIRE(picture2->load(TEST_DIR"/test.json") == Result::Success);
+        REQUIRE(picture2->size(100, 100) == Result::Success);
+
+        auto canvas = unique_ptr<SwCanvas>(SwCanvas::gen());
+        REQUIRE(canvas->target(buffer, 100, 100, 100, ColorSpace::ARGB8888) == Result::Success);
+        REQUIRE(canvas->push(picture) == Result::Success);
+
+        auto canvas2 = unique_ptr<SwCanvas>(SwCanvas::gen());
+        REQUIRE(canvas2->target(buffer2, 100, 100, 100, ColorSpace::ARGB8888) == Result::Success);
+        REQUIRE(canvas2->push(picture2) == Result::Success);
+
+        auto compare = [&](float no) {
+            REQUIRE(animation->frame(no) == Result::Success);
+            REQUIRE(animation2->frame(no) == Result::Success);
+            REQUIRE(animation->curFrame() == animation2->curFrame());
+            REQUIRE(canvas->update() == Result::Success);
+            REQUIRE(canvas->draw(true) == Result::Success);
+            REQUIRE(canvas->sync() == Result::Success);
+            REQUIRE(canvas2->update() == Result::Success);
+            REQUIRE(canvas2->draw(true) == Result::Success);
+            REQUIRE(canvas2->sync() == Result::Success);
+            REQUIRE(memcmp(buffer, buffer2, sizeof(buffer)) == 0);
+        };
+
+        //the second loop is drawn by the stored frames
+        REQUIRE(animation->cache(1024 * 1024) == Result::Success);
+        for (int loop = 0; loop < 2; ++loop) {
+            for (int i = 0; i < 8; ++i) compare(1.0f + 2.0f * i);
+        }
+
+        //by the differences from the first frame
+        REQUIRE(animation->cache(1024 * 1024, true) == Result::Success);
+        for (int loop = 0; loop < 2; ++loop) {
+            for (int i = 0; i < 8; ++i) compare(1.0f + 2.0f * i);
+        }
+
+        //a small budget keeps no frames
+        REQUIRE(animation->cache(100) == Result::Success);
+        compare(2.0f);
+        compare(1.0f);
+
+        //back to the scene
+        REQUIRE(animation->cache(0) == Result::Success);
+        compare(3.0f);
+
+        //a budget of two frames keeps the latest ones
+        REQUIRE(animation->cache(2 * sizeof(buffer)) == Result::Success);
+        for (int loop = 0; loop < 2; ++loop) {
+            for (int i = 0; i < 4; ++i) compare(1.0f + 2.0f * i);
+        }
+
+        //the picture outlives the animation, it draws its scene without the released frames
+        animation.reset();
+        REQUIRE(canvas->update() == Result::Success);
+        REQUIRE(canvas->draw(true) == Result::Success);
+        REQUIRE(canvas->sync() == Result::Success);
+        REQUIRE(memcmp(buffer, buffer2, sizeof(buffer)) == 0);
+
+        //the expressions have the states per animation
+        auto animation3 = unique_ptr<LottieAnimation>(LottieAnimation::gen());
+        REQUIRE(animation3->picture()->load(TEST_DIR"/test6.json") == Result::Success);
+        REQUIRE(animation3->cache(1024 * 1024) == Result::NonSupport);
+    }
+    REQUIRE(Initializer::term() == Result::Success);
+#endif
+}
+
+TEST_CASE("Lottie Frame Budget", "[tvgLottie]")
+{
+#ifdef THORVG_SW_RASTER_SUPPORT
+    static uint32_t buffer[100*100];
+
+    REQUIRE(Initializer::init() == Result::Success);
+    {
+        auto animation = unique_ptr<LottieAnimation>(LottieAnimation::gen());
+        REQUIRE(animation->budget(10.0f) == Result::InsufficientCondition);
+        REQUIRE(animation->quality() == 100);
+
+        auto picture = animation->picture();
+        REQUIRE(picture->load(TEST_DIR"/test.json") == Result::Success);
+        REQUIRE(picture->size(100, 100) == Result::Success);
+        REQUIRE(animation->budget(-1.0f) == Result::InvalidArguments);
+
+        auto canvas = unique_ptr<SwCanvas>(SwCanvas::gen());
+        REQUIRE(canvas->target(buffer, 100, 100, 100, ColorSpace::ARGB8888) == Result::Success);
+        REQUIRE(canvas->push(picture) == Result::Success);
+
+        auto play = [&](int cnt) {
+            for (int i = 0; i < cnt; ++i) {
+                REQUIRE(animation->frame(float(1 + i % 2)) == Result::Success);
+                REQUIRE(canvas->update() == Result::Success);
+                REQUIRE(canvas->draw(true) == Result::Success);
+                REQUIRE(canvas->sync() == Result::Success);
+            }
+        };
+
+        //no frame could make it
+        REQUIRE(animation->budget(0.000001f) == Result::Success);
+        play(2);
+        REQUIRE(animation->quality() < 100);
+        play(10);
+        REQUIRE(animation->quality() == 0);
+
+        //plenty of time
+        REQUIRE(animation->budget(1000000.0f) == Result::Success);
+        play(30);
+        REQUIRE(animation->quality() > 0);
+        play(100);
+        REQUIRE(animation->quality() == 100);
+
+        REQUIRE(animation->budget(0.000001f) == Result::Success);
+        play(12);
+        REQUIRE(animation->quality() == 0);
+        REQUIRE(animation->budget(0.0f) == Result::Success);
+        REQUIRE(animation->quality() == 100);
+        play(2);
+
+        //each level drops its features: the blur quality, the blending and the faint layers
+        auto animation2 = unique_ptr<LottieAnimation>(LottieAnimation::gen());
+        auto picture2 = animation2->picture();
+        REQUIRE(picture2->load(TEST_DIR"/test13.json") == Result::Success);
+        REQUIRE(canvas->remove() == Result::Success);
+        REQUIRE(canvas->push(picture2) == Result::Success);
+        REQUIRE(animation2->budget(0.000001f) == Result::Success);
+
+        static uint32_t levels[4][100*100];
+        for (int i = 0, level = 0; level < 4; ++i) {
+            //the frame is built in the quality of the moment
+            auto current = 3 - animation2->quality() * 3 / 100;
+            REQUIRE(animation2->frame(float(1 + i % 2)) == Result::Success);
+            REQUIRE(canvas->update() == Result::Success);
+            REQUIRE(canvas->draw(true) == Result::Success);
+            REQUIRE(canvas->sync() == Result::Success);
+            if (current == level) memcpy(levels[level++], buffer, sizeof(buffer));
+        }
+
+        auto fullBlur = [&](int level) { return memcmp(levels[level] + 60 * 100, levels[0] + 60 * 100, 30 * 100 * sizeof(uint32_t)) == 0; };
+        auto difference = [&](int level) { return levels[level][25 * 100 + 50] == 0xff00ffff; };
+        auto faint = [&](int level) { return levels[level][90 * 100 + 10] != 0; };
+
+        REQUIRE(difference(0));
+        REQUIRE(faint(0));
+
+        REQUIRE(!fullBlur(1));
+        REQUIRE(difference(1));
+        REQUIRE(faint(1));
+
+        REQUIRE(!fullBlur(2));
+        REQUIRE(levels[2][25 * 100 + 50] == 0xffff0000);
+        REQUIRE(faint(2));
+
+        REQUIRE(!fullBlur(3));
+        REQUIRE(!difference(3));
+        REQUIRE(!faint(3));
+    }
+    REQUIRE(Initializer::term() == Result::Success);
+#endif
+}
+
+TEST_CASE("Lottie Binary", "[tvgLottie]")
+{
+    REQUIRE(Initializer::init() == Result::Success);
+    {
+        //the pre-tokenized data must be loaded as same as its origin
+        auto origin = unique_ptr<LottieAnimation>(LottieAnimation::gen());
+        REQUIRE(origin->picture()->load(TEST_DIR"/lottieslot.json") == Result::Success);
+
+        auto animation = unique_ptr<LottieAnimation>(LottieAnimation::gen());
+        auto picture = animation->picture();
+        REQUIRE(picture->load(TEST_DIR"/lottieslot.lotb") == Result::Success);
+
+        float w1, h1, w2, h2;
+        REQUIRE(origin->picture()->size(&w1, &h1) == Result::Success);
+        REQUIRE(picture->size(&w2, &h2) == Result::Success);
+        REQUIRE(w1 == w2);
+        REQUIRE(h1 == h2);
+        REQUIRE(origin->totalFrame() == animation->totalFrame());
+        REQUIRE(animation->frame(animation->totalFrame() * 0.5f) == Result::Success);
+
+        //slots
+        REQUIRE(animation->override(R"({"gradient_fill":{"p":{"p":2,"k":{"a":0,"k":[0,0.1,0.1,0.2,1,1,0.1,0.2,0.1,1]}}}})") == Result::Success);
+        REQUIRE(animation->override(nullptr) == Result::Success);
+
+        //load from the data
+        ifstream file(TEST_DIR"/lottieslot.lotb", ios::in | ios::binary);
+        REQUIRE(file.is_open());
+        file.seekg(0, std::ios::end);
+        auto size = file.tellg();
+        file.seekg(0, std::ios::beg);
+        auto data = (char*)malloc(size);
+        REQUIRE(data);
+        file.read(data, size);
+        file.close();
+
+        auto animation2 = unique_ptr<LottieAnimation>(LottieAnimation::gen());
+        REQUIRE(animation2->picture()->load(data, size, "lotb", "", true) == Result::Success);
+        REQUIRE(animation2->totalFrame() == animation->totalFrame());
+
+        //written in the other byte order
+        swap(data[6], data[7]);
+        auto animation3 = unique_ptr<LottieAnimation>(LottieAnimation::gen());
+        REQUIRE(animation3->picture()->load(data, size, "lotb", "", true) != Result::Success);
+
+        //the foreign one falls back to its json origin next to it
+        ofstream foreign(TEST_DIR"/lottiefallback.lotb", ios::out | ios::binary);
+        REQUIRE(foreign.write(data, size));
+        foreign.close();
+
+        ifstream json(TEST_DIR"/lottieslot.json", ios::in | ios::binary);
+        ofstream fallback(TEST_DIR"/lottiefallback.json", ios::out | ios::binary);
+        fallback << json.rdbuf();
+        fallback.close();
+        json.close();
+
+        auto animation4 = unique_ptr<LottieAnimation>(LottieAnimation::gen());
+        REQUIRE(animation4->picture()->load(TEST_DIR"/lottiefallback.lotb") == Result::Success);
+        REQUIRE(animation4->totalFrame() == origin->totalFrame());
+        REQUIRE(animation4->frame(animation4->totalFrame() * 0.5f) == Result::Success);
+
+        REQUIRE(remove(TEST_DIR"/lottiefallback.lotb") == 0);
+        REQUIRE(remove(TEST_DIR"/lottiefallback.json") == 0);
+
+        //unsupported version
+        swap(data[6], data[7]);
+        data[4] = (char)0xff;
+        auto animation5 = unique_ptr<LottieAnimation>(LottieAnimation::gen());
+        REQUIRE(animation5->picture()->load(data, size, "lotb", "", true) != Result::Success);
+
+        free(data);
+    }
+    REQUIRE(Initializer::term() == Result::Success);
+}
+
+TEST_CASE("Lottie Shared Model", "[tvgLottie]")
+{
+    REQUIRE(Initializer::init() == Result::Success);
+    {
+        const char* slotJson = R"({"gradient_fill":{"p":{"p":2,"k":{"a":0,"k":[0,0.1,0.1,0.2,1,1,0.1,0.2,0.1,1]}}}})";
+
+        auto animation = unique_ptr<LottieAnimation>(LottieAnimation::gen());
+        REQUIRE(animation->picture()->load(TEST_DIR"/lottieslot.json") == Result::Success);
+
+        //the same file shares the model of the first one
+        auto animation2 = unique_ptr<LottieAnimation>(LottieAnimation::gen());
+        REQUIRE(animation2->picture()->load(TEST_DIR"/lottieslot.json") == Result::Success);
+
+        float w1, h1, w2, h2;
+        REQUIRE(animation->picture()->size(&w1, &h1) == Result::Success);
+        REQUIRE(animation2->picture()->size(&w2, &h2) == Result::Success);
+        REQUIRE(w1 == w2);
+        REQUIRE(h1 == h2);
+        REQUIRE(animation->totalFrame() == animation2->totalFrame());
+        REQUIRE(animation2->frame(animation2->totalFrame() * 0.5f) == Result::Success);
+
+        //only the later one borrows the keyframes
+        REQUIRE(animation->shared() == 0);
+        REQUIRE(animation2->shared() > 0);
+
+        //the slots are overridden per instance
+        REQUIRE(animation2->override(slotJson) == Result::Success);
+        REQUIRE(animation->frame(animation->totalFrame() * 0.5f) == Result::Success);
+        REQUIRE(animation2->override(nullptr) == Result::Success);
+        REQUIRE(animation->override(slotJson) == Result::Success);
+
+        //the shared model outlives its first owner, once its slots are restored
+        REQUIRE(animation->override(nullptr) == Result::Success);
+        animation.reset();
+        auto animation3 = unique_ptr<LottieAnimation>(LottieAnimation::gen());
+        REQUIRE(animation3->picture()->load(TEST_DIR"/lottieslot.json") == Result::Success);
+        REQUIRE(animation3->shared() == animation2->shared());
+        REQUIRE(animation3->frame(1.0f) == Result::Success);
+        REQUIRE(animation3->override(slotJson) == Result::Success);
+        REQUIRE(animation2->frame(1.0f) == Result::Success);
+
+        //the expressions are evaluated per instance, not to be shared
+        auto animation4 = unique_ptr<LottieAnimation>(LottieAnimation::gen());
+        REQUIRE(animation4->picture()->load(TEST_DIR"/test6.json") == Result::Success);
+        auto animation5 = unique_ptr<LottieAnimation>(LottieAnimation::gen());
+        REQUIRE(animation5->picture()->load(TEST_DIR"/test6.json") == Result::Success);
+        REQUIRE(animation5->shared() == 0);
+    }
+    REQUIRE(Initializer::term() == Result::Success);
+}
+
 #endif
\ No newline at end of file
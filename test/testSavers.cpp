@@ -22,6 +22,7 @@
 
 #include <thorvg.h>
 #include <fstream>
+#include <cstdio>
 #include "config.h"
 #include "catch.hpp"
 
@@ -68,6 +69,9 @@ TEST_CASE("Save a lottie into gif", "[tvgSavers]") {
         REQUIRE(saver->background(bg) == Result::Success);
         REQUIRE(saver->save(animation2, TEST_DIR"/test.gif") == Result::Success);
         REQUIRE(saver->sync() == Result::Success);
+
+        //the output is not a resource of the tests
+        REQUIRE(remove(TEST_DIR"/test.gif") == 0);
     }
     REQUIRE(Initializer::term() == Result::Success);
 }
@@ -103,3 +103,171 @@ TEST_CASE("Scene Clear And Reuse Shape", "[tvgScene]")
     }
     REQUIRE(Initializer::term() == Result::Success);
 }
+
+TEST_CASE("Scene Children Order", "[tvgScene]")
+{
+    auto scene = unique_ptr<Scene>(Scene::gen());
+    REQUIRE(scene);
+
+    Paint* paints[4];
+    for (int i = 0; i < 3; ++i) {
+        paints[i] = Shape::gen();
+        REQUIRE(scene->push(paints[i]) == Result::Success);
+    }
+
+    //Insert in front of the second
+    paints[3] = Shape::gen();
+    REQUIRE(scene->push(paints[3], paints[1]) == Result::Success);
+
+    auto& list = scene->paints();
+    REQUIRE(list.size() == 4);
+    Paint* expected[] = {paints[0], paints[3], paints[1], paints[2]};
+    auto i = 0;
+    for (auto paint : list) REQUIRE(paint == expected[i++]);
+
+    //Remove the middle
+    REQUIRE(scene->remove(paints[3]) == Result::Success);
+    REQUIRE(scene->paints().size() == 3);
+    REQUIRE(scene->paints().front() == paints[0]);
+    REQUIRE(scene->paints().back() == paints[2]);
+}
+
+TEST_CASE("Scene Intersection", "[tvgScene]")
+{
+    REQUIRE(Initializer::init() == Result::Success);
+    {
+        auto canvas = unique_ptr<SwCanvas>(SwCanvas::gen());
+        uint32_t buffer[200*200];
+        canvas->target(buffer, 200, 200, 200, ColorSpace::ARGB8888);
+
+        //large enough to build the spatial index
+        auto scene = Scene::gen();
+        for (int y = 0; y < 10; ++y) {
+            for (int x = 0; x < 10; ++x) {
+                auto shape = Shape::gen();
+                shape->appendRect(x * 20, y * 20, 10, 10);
+                shape->fill(255, 255, 255);
+                scene->push(shape);
+            }
+        }
+        REQUIRE(canvas->push(scene) == Result::Success);
+        REQUIRE(canvas->update() == Result::Success);
+        REQUIRE(canvas->draw() == Result::Success);
+        REQUIRE(canvas->sync() == Result::Success);
+
+        REQUIRE(scene->intersects(2, 2, 2, 2));
+        REQUIRE(scene->intersects(185, 185, 4, 4));
+        REQUIRE(!scene->intersects(12, 12, 5, 5));
+        REQUIRE(!scene->intersects(112, 52, 5, 5));
+        REQUIRE(scene->intersects(5, 5, 100, 100));
+
+        int32_t regions[] = {185, 185, 4, 4, 112, 52, 5, 5, 2, 2, 2, 2};
+        Paint* hits[3];
+        REQUIRE(scene->pick(regions, 3, hits) == Result::Success);
+        REQUIRE(hits[0] == scene->paints().back());
+        REQUIRE(hits[1] == nullptr);
+        REQUIRE(hits[2] == scene->paints().front());
+
+        //Spatial index must follow the scene changes
+        auto shape = Shape::gen();
+        shape->appendRect(110, 50, 10, 10);
+        shape->fill(255, 255, 255);
+        REQUIRE(scene->push(shape) == Result::Success);
+        REQUIRE(canvas->update() == Result::Success);
+        REQUIRE(canvas->draw() == Result::Success);
+        REQUIRE(canvas->sync() == Result::Success);
+        REQUIRE(scene->intersects(112, 52, 5, 5));
+    }
+    REQUIRE(Initializer::term() == Result::Success);
+}
+
+TEST_CASE("Scene Viewport Culling", "[tvgScene]")
+{
+    REQUIRE(Initializer::init() == Result::Success);
+    {
+        auto canvas = unique_ptr<SwCanvas>(SwCanvas::gen());
+        static uint32_t buffer[200*200];
+        canvas->target(buffer, 200, 200, 200, ColorSpace::ARGB8888);
+        REQUIRE(canvas->viewport(0, 0, 100, 100) == Result::Success);
+
+        //large enough to draw the children within the viewport only, the overlapped ones keep the order
+        auto scene = Scene::gen();
+        for (int y = 0; y < 10; ++y) {
+            for (int x = 0; x < 10; ++x) {
+                auto bottom = Shape::gen();
+                bottom->appendRect(x * 20, y * 20, 10, 10);
+                bottom->fill(255, 0, 0);
+                scene->push(bottom);
+                auto top = Shape::gen();
+                top->appendRect(x * 20 + 5, y * 20, 10, 10);
+                top->fill(0, 0, 255);
+                scene->push(top);
+            }
+        }
+        REQUIRE(canvas->push(scene) == Result::Success);
+        REQUIRE(canvas->update() == Result::Success);
+        REQUIRE(canvas->draw(true) == Result::Success);
+        REQUIRE(canvas->sync() == Result::Success);
+
+        for (int y = 0; y < 10; ++y) {
+            for (int x = 0; x < 10; ++x) {
+                auto visible = (x < 5 && y < 5);
+                REQUIRE(buffer[(y * 20 + 5) * 200 + x * 20 + 2] == (visible ? 0xffff0000 : 0));
+                REQUIRE(buffer[(y * 20 + 5) * 200 + x * 20 + 7] == (visible ? 0xff0000ff : 0));
+            }
+        }
+    }
+    REQUIRE(Initializer::term() == Result::Success);
+}
+
+TEST_CASE("Scene Batched Picking", "[tvgScene]")
+{
+    REQUIRE(Initializer::init() == Result::Success);
+    {
+        auto canvas = unique_ptr<SwCanvas>(SwCanvas::gen());
+        uint32_t buffer[200*200];
+        canvas->target(buffer, 200, 200, 200, ColorSpace::ARGB8888);
+
+        auto scene = Scene::gen();
+
+        auto bottom = Shape::gen();
+        bottom->appendRect(0, 0, 100, 100);
+        bottom->fill(255, 0, 0);
+        scene->push(bottom);
+
+        auto group = Scene::gen();
+        auto top = Shape::gen();
+        top->appendRect(50, 50, 100, 100);
+        top->fill(0, 255, 0);
+        group->push(top);
+        scene->push(group);
+
+        REQUIRE(canvas->push(scene) == Result::Success);
+        REQUIRE(canvas->update() == Result::Success);
+        REQUIRE(canvas->draw() == Result::Success);
+        REQUIRE(canvas->sync() == Result::Success);
+
+        int32_t regions[] = {10, 10, 1, 1, 60, 60, 1, 1, 120, 120, 1, 1, 180, 10, 1, 1};
+        Paint* hits[4];
+
+        REQUIRE(scene->pick(nullptr, 4, hits) == Result::InvalidArguments);
+        REQUIRE(scene->pick(regions, 4, nullptr) == Result::InvalidArguments);
+
+        //topmost
+        REQUIRE(scene->pick(regions, 4, hits) == Result::Success);
+        REQUIRE(hits[0] == bottom);
+        REQUIRE(hits[1] == top);
+        REQUIRE(hits[2] == top);
+        REQUIRE(hits[3] == nullptr);
+
+        //all hits
+        auto cnt = 0;
+        auto func = [](uint32_t idx, Paint* paint, void* data) -> bool {
+            if (idx == 1) ++(*static_cast<int*>(data));
+            return true;
+        };
+        REQUIRE(scene->pick(regions, 4, func, &cnt) == Result::Success);
+        REQUIRE(cnt == 2);
+    }
+    REQUIRE(Initializer::term() == Result::Success);
+}
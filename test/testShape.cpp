@@ -129,6 +129,95 @@ TEST_CASE("Appending Paths", "[tvgShape]")
     REQUIRE(pts2Cnt == 0);
 }
 
+TEST_CASE("Duplicating Paths", "[tvgShape]")
+{
+    auto shape = unique_ptr<Shape>(Shape::gen());
+    REQUIRE(shape);
+    REQUIRE(shape->appendRect(0, 0, 100, 100) == Result::Success);
+
+    auto dup = unique_ptr<Shape>(static_cast<Shape*>(shape->duplicate()));
+    REQUIRE(dup);
+
+    const Point* pts1;
+    const Point* pts2;
+    uint32_t cnt1, cnt2;
+
+    //The path data is shared until it's changed
+    REQUIRE(shape->path(nullptr, nullptr, &pts1, &cnt1) == Result::Success);
+    REQUIRE(dup->path(nullptr, nullptr, &pts2, &cnt2) == Result::Success);
+    REQUIRE(cnt1 == cnt2);
+    REQUIRE(pts1 == pts2);
+
+    //Modify the duplicated
+    REQUIRE(dup->lineTo(200, 200) == Result::Success);
+    REQUIRE(dup->path(nullptr, nullptr, &pts2, &cnt2) == Result::Success);
+    REQUIRE(cnt2 == cnt1 + 1);
+    REQUIRE(pts1 != pts2);
+    REQUIRE(shape->path(nullptr, nullptr, &pts1, &cnt1) == Result::Success);
+    REQUIRE(cnt1 == 4);
+
+    //Modify the origin
+    auto dup2 = unique_ptr<Shape>(static_cast<Shape*>(shape->duplicate()));
+    REQUIRE(shape->appendCircle(50, 50, 10, 10) == Result::Success);
+    REQUIRE(dup2->path(nullptr, nullptr, &pts2, &cnt2) == Result::Success);
+    REQUIRE(cnt2 == 4);
+    for (int i = 0; i < 4; ++i) {
+        REQUIRE(((pts2[i].x == 0.0f) || (pts2[i].x == 100.0f)));
+        REQUIRE(((pts2[i].y == 0.0f) || (pts2[i].y == 100.0f)));
+    }
+
+    //Reset the origin
+    REQUIRE(shape->reset() == Result::Success);
+    REQUIRE(dup2->path(nullptr, nullptr, &pts2, &cnt2) == Result::Success);
+    REQUIRE(cnt2 == 4);
+    REQUIRE(pts2[0].x == 100.0f);
+}
+
+TEST_CASE("Shape Instances", "[tvgShape]")
+{
+    auto shape = unique_ptr<Shape>(Shape::gen());
+    REQUIRE(shape);
+    REQUIRE(shape->appendRect(0, 0, 10, 10) == Result::Success);
+
+    //Negative cases
+    REQUIRE(shape->instances(nullptr, nullptr, 3) == Result::InvalidArguments);
+
+    Matrix transforms[3] = {
+        {1.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 1.0f},
+        {1.0f, 0.0f, 100.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 1.0f},
+        {2.0f, 0.0f, 0.0f, 0.0f, 1.0f, 50.0f, 0.0f, 0.0f, 1.0f}
+    };
+    uint8_t opacities[3] = {255, 128, 0};
+
+    REQUIRE(shape->instances(transforms, nullptr, 3) == Result::Success);
+    REQUIRE(shape->instances(transforms, opacities, 3) == Result::Success);
+
+    //Union of the instances
+    float x, y, w, h;
+    REQUIRE(shape->bounds(&x, &y, &w, &h) == Result::Success);
+    REQUIRE(x == Approx(0.0f).margin(0.000001));
+    REQUIRE(y == Approx(0.0f).margin(0.000001));
+    REQUIRE(w == Approx(110.0f).margin(0.000001));
+    REQUIRE(h == Approx(60.0f).margin(0.000001));
+
+    //The shape transform is applied after the instances
+    REQUIRE(shape->translate(10, 10) == Result::Success);
+    REQUIRE(shape->bounds(&x, &y, &w, &h) == Result::Success);
+    REQUIRE(x == Approx(10.0f).margin(0.000001));
+    REQUIRE(w == Approx(110.0f).margin(0.000001));
+
+    //Duplication
+    auto dup = unique_ptr<Shape>(static_cast<Shape*>(shape->duplicate()));
+    REQUIRE(dup->bounds(&x, &y, &w, &h) == Result::Success);
+    REQUIRE(w == Approx(110.0f).margin(0.000001));
+    REQUIRE(h == Approx(60.0f).margin(0.000001));
+
+    //Clear
+    REQUIRE(shape->instances(nullptr, nullptr, 0) == Result::Success);
+    REQUIRE(shape->bounds(&x, &y, &w, &h) == Result::Success);
+    REQUIRE(w == Approx(10.0f).margin(0.000001));
+}
+
 TEST_CASE("Stroking", "[tvgShape]")
 {
     auto shape = unique_ptr<Shape>(Shape::gen());
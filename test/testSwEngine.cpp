@@ -22,6 +22,7 @@
 
 #include <thorvg.h>
 #include <fstream>
+#include <cstring>
 #include "config.h"
 #include "catch.hpp"
 
@@ -1473,4 +1474,302 @@ TEST_CASE("Blending with Gradient Filling", "[tvgSwEngine]")
     }
     REQUIRE(Initializer::term() == Result::Success);
 }
+
+TEST_CASE("Offscreen Culling", "[tvgSwEngine]")
+{
+    REQUIRE(Initializer::init() == Result::Success);
+    {
+        auto canvas = unique_ptr<SwCanvas>(SwCanvas::gen());
+        REQUIRE(canvas);
+
+        uint32_t buffer[100*100];
+        REQUIRE(canvas->target(buffer, 100, 100, 100, ColorSpace::ARGB8888) == Result::Success);
+
+        //Out of the viewport
+        auto shape = Shape::gen();
+        REQUIRE(shape->appendRect(0, 0, 10, 10) == Result::Success);
+        REQUIRE(shape->fill(255, 255, 255, 255) == Result::Success);
+        REQUIRE(shape->translate(500, 500) == Result::Success);
+        REQUIRE(canvas->push(shape) == Result::Success);
+        REQUIRE(canvas->draw(true) == Result::Success);
+        REQUIRE(canvas->sync() == Result::Success);
+        REQUIRE(!shape->intersects(0, 0, 100, 100));
+
+        //Changed while out of the viewport
+        REQUIRE(shape->fill(255, 0, 0, 255) == Result::Success);
+        REQUIRE(canvas->update() == Result::Success);
+        REQUIRE(canvas->draw(true) == Result::Success);
+        REQUIRE(canvas->sync() == Result::Success);
+
+        //Scrolled into the viewport
+        REQUIRE(shape->translate(45, 45) == Result::Success);
+        REQUIRE(canvas->update() == Result::Success);
+        REQUIRE(canvas->draw(true) == Result::Success);
+        REQUIRE(canvas->sync() == Result::Success);
+        REQUIRE(shape->intersects(50, 50));
+        REQUIRE(buffer[50 * 100 + 50] == 0xffff0000);
+    }
+    REQUIRE(Initializer::term() == Result::Success);
+}
+
+TEST_CASE("Instanced Shapes", "[tvgSwEngine]")
+{
+    REQUIRE(Initializer::init() == Result::Success);
+    {
+        auto canvas = unique_ptr<SwCanvas>(SwCanvas::gen());
+        REQUIRE(canvas);
+
+        uint32_t buffer[100*100];
+        REQUIRE(canvas->target(buffer, 100, 100, 100, ColorSpace::ARGB8888) == Result::Success);
+
+        auto shape = Shape::gen();
+        REQUIRE(shape->appendCircle(10, 10, 8, 8) == Result::Success);
+        REQUIRE(shape->fill(255, 255, 255, 255) == Result::Success);
+        REQUIRE(canvas->push(shape) == Result::Success);
+
+        //Integer offsets, sub-pixel offsets and the clipped ones
+        Point offsets[] = {{20, 0}, {40, 40}, {0, 60.5f}, {95, 95}};
+        for (auto& offset : offsets) {
+            auto dup = static_cast<Shape*>(shape->duplicate());
+            REQUIRE(dup->translate(offset.x, offset.y) == Result::Success);
+            REQUIRE(canvas->push(dup) == Result::Success);
+        }
+
+        REQUIRE(canvas->draw(true) == Result::Success);
+        REQUIRE(canvas->sync() == Result::Success);
+
+        for (int y = 0; y < 20; ++y) {
+            for (int x = 0; x < 20; ++x) {
+                REQUIRE(buffer[y * 100 + x] == buffer[y * 100 + x + 20]);
+                REQUIRE(buffer[y * 100 + x] == buffer[(y + 40) * 100 + x + 40]);
+            }
+        }
+        REQUIRE(buffer[70 * 100 + 10] == 0xffffffff);
+        REQUIRE(buffer[99 * 100 + 99] != 0);
+
+        //Changed instance
+        auto dup = static_cast<Shape*>(shape->duplicate());
+        REQUIRE(dup->appendRect(50, 5, 10, 10) == Result::Success);
+        REQUIRE(dup->translate(40, 0) == Result::Success);
+        REQUIRE(canvas->push(dup) == Result::Success);
+        REQUIRE(canvas->draw(true) == Result::Success);
+        REQUIRE(canvas->sync() == Result::Success);
+        REQUIRE(buffer[10 * 100 + 95] == 0xffffffff);
+    }
+    REQUIRE(Initializer::term() == Result::Success);
+}
+
+TEST_CASE("Instanced Shapes with Disposed Leader", "[tvgSwEngine]")
+{
+    REQUIRE(Initializer::init() == Result::Success);
+    {
+        auto canvas = unique_ptr<SwCanvas>(SwCanvas::gen());
+        REQUIRE(canvas);
+
+        uint32_t buffer[100*100];
+        REQUIRE(canvas->target(buffer, 100, 100, 100, ColorSpace::ARGB8888) == Result::Success);
+
+        auto leader = Shape::gen();
+        REQUIRE(leader->appendCircle(10, 10, 8, 8) == Result::Success);
+        REQUIRE(leader->fill(255, 255, 255, 255) == Result::Success);
+        auto dup = static_cast<Shape*>(leader->duplicate());
+        REQUIRE(dup->translate(20, 0) == Result::Success);
+        REQUIRE(canvas->push(leader) == Result::Success);
+        REQUIRE(canvas->push(dup) == Result::Success);
+        REQUIRE(canvas->update() == Result::Success);
+
+        //the leader is disposed, then the same path is prepared again before the sync
+        REQUIRE(canvas->remove(leader) == Result::Success);
+        auto dup2 = static_cast<Shape*>(dup->duplicate());
+        REQUIRE(dup2->translate(40, 0) == Result::Success);
+        REQUIRE(canvas->push(dup2) == Result::Success);
+        REQUIRE(canvas->update() == Result::Success);
+        REQUIRE(canvas->draw(true) == Result::Success);
+        REQUIRE(canvas->sync() == Result::Success);
+
+        REQUIRE(buffer[10 * 100 + 10] == 0);
+        REQUIRE(buffer[10 * 100 + 30] == 0xffffffff);
+        REQUIRE(buffer[10 * 100 + 50] == 0xffffffff);
+        for (int y = 0; y < 20; ++y) {
+            for (int x = 0; x < 20; ++x) {
+                REQUIRE(buffer[y * 100 + x + 20] == buffer[y * 100 + x + 40]);
+            }
+        }
+    }
+    REQUIRE(Initializer::term() == Result::Success);
+}
+
+TEST_CASE("Instanced Drawing", "[tvgSwEngine]")
+{
+    REQUIRE(Initializer::init() == Result::Success);
+    {
+        auto canvas = unique_ptr<SwCanvas>(SwCanvas::gen());
+        REQUIRE(canvas);
+
+        uint32_t buffer[100*100];
+        REQUIRE(canvas->target(buffer, 100, 100, 100, ColorSpace::ARGB8888) == Result::Success);
+
+        auto shape = Shape::gen();
+        REQUIRE(shape->appendRect(0, 0, 10, 10) == Result::Success);
+        REQUIRE(shape->fill(255, 255, 255, 255) == Result::Success);
+        REQUIRE(canvas->push(shape) == Result::Success);
+
+        //Grid of the copies
+        Matrix transforms[25];
+        uint8_t opacities[25];
+        for (int i = 0; i < 25; ++i) {
+            transforms[i] = {1.0f, 0.0f, float((i % 5) * 20), 0.0f, 1.0f, float((i / 5) * 20), 0.0f, 0.0f, 1.0f};
+            opacities[i] = (i == 24) ? 0 : 255;
+        }
+        REQUIRE(shape->instances(transforms, opacities, 25) == Result::Success);
+
+        REQUIRE(canvas->update() == Result::Success);
+        REQUIRE(canvas->draw(true) == Result::Success);
+        REQUIRE(canvas->sync() == Result::Success);
+
+        REQUIRE(buffer[5 * 100 + 5] == 0xffffffff);
+        REQUIRE(buffer[45 * 100 + 65] == 0xffffffff);
+        REQUIRE(buffer[15 * 100 + 15] == 0);
+        REQUIRE(buffer[85 * 100 + 85] == 0);
+        REQUIRE(shape->intersects(60, 40, 5, 5));
+        REQUIRE(!shape->intersects(30, 30, 5, 5));
+
+        //Fewer instances
+        REQUIRE(shape->instances(transforms, nullptr, 2) == Result::Success);
+        REQUIRE(canvas->update() == Result::Success);
+        REQUIRE(canvas->draw(true) == Result::Success);
+        REQUIRE(canvas->sync() == Result::Success);
+        REQUIRE(buffer[5 * 100 + 25] == 0xffffffff);
+        REQUIRE(buffer[45 * 100 + 65] == 0);
+
+        //Translucent stroking instances
+        REQUIRE(shape->strokeWidth(2) == Result::Success);
+        REQUIRE(shape->strokeFill(255, 0, 0, 255) == Result::Success);
+        REQUIRE(shape->opacity(128) == Result::Success);
+        REQUIRE(canvas->update() == Result::Success);
+        REQUIRE(canvas->draw(true) == Result::Success);
+        REQUIRE(canvas->sync() == Result::Success);
+        REQUIRE(buffer[5 * 100 + 25] == buffer[5 * 100 + 5]);
+    }
+    REQUIRE(Initializer::term() == Result::Success);
+}
+
+#ifdef THORVG_TTF_LOADER_SUPPORT
+TEST_CASE("Cached Glyph Drawing", "[tvgSwEngine]")
+{
+    REQUIRE(Initializer::init() == Result::Success);
+    {
+        auto canvas = unique_ptr<SwCanvas>(SwCanvas::gen());
+        REQUIRE(canvas);
+
+        uint32_t buffer[100*100];
+        uint32_t prev[100*100];
+        REQUIRE(canvas->target(buffer, 100, 100, 100, ColorSpace::ARGB8888) == Result::Success);
+
+        REQUIRE(Text::load(TEST_DIR"/Arial.ttf") == Result::Success);
+
+        auto text = Text::gen();
+        REQUIRE(text->font("Arial", 12) == Result::Success);
+        REQUIRE(text->text("0110 fix") == Result::Success);
+        REQUIRE(text->fill(255, 255, 255) == Result::Success);
+        REQUIRE(text->translate(10, 10) == Result::Success);
+        REQUIRE(canvas->push(text) == Result::Success);
+        REQUIRE(canvas->draw(true) == Result::Success);
+        REQUIRE(canvas->sync() == Result::Success);
+        memcpy(prev, buffer, sizeof(buffer));
+
+        //the same glyph coverages at the pixel offset
+        REQUIRE(text->translate(30, 40) == Result::Success);
+        REQUIRE(canvas->update() == Result::Success);
+        REQUIRE(canvas->draw(true) == Result::Success);
+        REQUIRE(canvas->sync() == Result::Success);
+
+        auto drawn = 0;
+        auto differs = 0;
+        for (int y = 0; y < 60; ++y) {
+            for (int x = 0; x < 70; ++x) {
+                if (buffer[(y + 30) * 100 + (x + 20)] != prev[y * 100 + x]) ++differs;
+                if (prev[y * 100 + x]) ++drawn;
+            }
+        }
+        REQUIRE(drawn > 0);
+        REQUIRE(differs == 0);
+
+        //the rotated and the large texts are drawn as the path
+        REQUIRE(text->rotate(30) == Result::Success);
+        REQUIRE(canvas->update() == Result::Success);
+        REQUIRE(canvas->draw(true) == Result::Success);
+        REQUIRE(canvas->sync() == Result::Success);
+
+        REQUIRE(text->font("Arial", 80) == Result::Success);
+        REQUIRE(text->rotate(0) == Result::Success);
+        REQUIRE(canvas->update() == Result::Success);
+        REQUIRE(canvas->draw(true) == Result::Success);
+        REQUIRE(canvas->sync() == Result::Success);
+
+        REQUIRE(Text::unload(TEST_DIR"/Arial.ttf") == Result::Success);
+    }
+    REQUIRE(Initializer::term() == Result::Success);
+}
+#endif
+
+TEST_CASE("Color Only Update", "[tvgSwEngine]")
+{
+    REQUIRE(Initializer::init() == Result::Success);
+    {
+        static uint32_t buffer[100*100];
+        static uint32_t buffer2[100*100];
+
+        auto stroked = [](Shape* shape, uint8_t r) {
+            if (!shape) {
+                shape = Shape::gen();
+                REQUIRE(shape->appendRect(20.3f, 20.7f, 50.2f, 40.1f, 5, 5) == Result::Success);
+                REQUIRE(shape->strokeWidth(1) == Result::Success);
+                REQUIRE(shape->strokeFill(200, 10, 10, 255) == Result::Success);
+                REQUIRE(shape->rotate(17) == Result::Success);
+            }
+            auto fill = LinearGradient::gen();
+            REQUIRE(fill->linear(20, 20, 70, 60) == Result::Success);
+            Fill::ColorStop colorStops[2] = {{0, r, 20, 30, 255}, {1, 40, 50, 60, 255}};
+            REQUIRE(fill->colorStops(colorStops, 2) == Result::Success);
+            REQUIRE(shape->fill(fill) == Result::Success);
+            return shape;
+        };
+
+        auto canvas = unique_ptr<SwCanvas>(SwCanvas::gen());
+        REQUIRE(canvas->target(buffer, 100, 100, 100, ColorSpace::ARGB8888) == Result::Success);
+        auto shape = stroked(nullptr, 200);
+        REQUIRE(canvas->push(shape) == Result::Success);
+        REQUIRE(canvas->draw(true) == Result::Success);
+        REQUIRE(canvas->sync() == Result::Success);
+
+        //the fill changed only, the stroke and the anti-aliased edges must stay as they are
+        stroked(shape, 10);
+        REQUIRE(canvas->update() == Result::Success);
+        REQUIRE(canvas->draw(true) == Result::Success);
+        REQUIRE(canvas->sync() == Result::Success);
+
+        auto canvas2 = unique_ptr<SwCanvas>(SwCanvas::gen());
+        REQUIRE(canvas2->target(buffer2, 100, 100, 100, ColorSpace::ARGB8888) == Result::Success);
+        REQUIRE(canvas2->push(stroked(nullptr, 10)) == Result::Success);
+        REQUIRE(canvas2->draw(true) == Result::Success);
+        REQUIRE(canvas2->sync() == Result::Success);
+        REQUIRE(memcmp(buffer, buffer2, sizeof(buffer)) == 0);
+
+        //solid color
+        REQUIRE(shape->fill(10, 20, 30, 255) == Result::Success);
+        REQUIRE(canvas->update() == Result::Success);
+        REQUIRE(canvas->draw(true) == Result::Success);
+        REQUIRE(canvas->sync() == Result::Success);
+
+        auto shape2 = stroked(nullptr, 10);
+        REQUIRE(shape2->fill(10, 20, 30, 255) == Result::Success);
+        REQUIRE(canvas2->remove() == Result::Success);
+        REQUIRE(canvas2->push(shape2) == Result::Success);
+        REQUIRE(canvas2->draw(true) == Result::Success);
+        REQUIRE(canvas2->sync() == Result::Success);
+        REQUIRE(memcmp(buffer, buffer2, sizeof(buffer)) == 0);
+    }
+    REQUIRE(Initializer::term() == Result::Success);
+}
 #endif
\ No newline at end of file
@@ -164,4 +164,33 @@ TEST_CASE("Text with composite glyphs", "[tvgText]")
     Initializer::term();
 }
 
+TEST_CASE("Text with repeated glyphs", "[tvgText]")
+{
+    Initializer::init();
+
+    REQUIRE(Text::load(TEST_DIR"/Arial.ttf") == tvg::Result::Success);
+
+    auto text = unique_ptr<Text>(Text::gen());
+    REQUIRE(text->font("Arial", 80) == tvg::Result::Success);
+
+    //the glyph outlines decoded once are reused, the layout must be the same
+    float x1, y1, w1, h1, x2, y2, w2, h2;
+    REQUIRE(text->text("0123456789") == tvg::Result::Success);
+    REQUIRE(text->bounds(&x1, &y1, &w1, &h1) == tvg::Result::Success);
+
+    REQUIRE(text->text("9876543210") == tvg::Result::Success);
+    REQUIRE(text->bounds(&x2, &y2, &w2, &h2) == tvg::Result::Success);
+
+    REQUIRE(text->text("0123456789") == tvg::Result::Success);
+    REQUIRE(text->bounds(&x2, &y2, &w2, &h2) == tvg::Result::Success);
+    REQUIRE(x1 == x2);
+    REQUIRE(y1 == y2);
+    REQUIRE(w1 == w2);
+    REQUIRE(h1 == h2);
+
+    REQUIRE(Text::unload(TEST_DIR"/Arial.ttf") == tvg::Result::Success);
+
+    Initializer::term();
+}
+
 #endif
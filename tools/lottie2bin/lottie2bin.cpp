@@ -0,0 +1,397 @@
+/*
+ * Copyright (c) 2025 the ThorVG project. All rights reserved.
+
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string.h>
+#include <vector>
+#include <memory>
+#include <thorvg.h>
+#include "rapidjson/reader.h"
+#include "tvgLottieBinary.h"
+#ifdef _WIN32
+    #define WIN32_LEAN_AND_MEAN
+    #include <windows.h>
+    #ifndef PATH_MAX
+        #define PATH_MAX MAX_PATH
+    #endif
+#else
+    #include <dirent.h>
+    #include <unistd.h>
+    #include <limits.h>
+    #include <sys/stat.h>
+#endif
+
+using namespace std;
+using namespace tvg;
+using namespace rapidjson;
+
+
+//Writes the json events as the flat tokens (see tvgLottieBinary.h)
+struct Encoder
+{
+   vector<char> data;
+   LottieBinaryHeader header = {{'T', 'L', 'O', 'T'}, LOTTIE_BINARY_VERSION, LOTTIE_BINARY_BYTE_ORDER, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f};
+   StringStream* ss = nullptr;
+   const char* src = nullptr;
+   float* info = nullptr;         //the top level animation info to be written in the header
+   size_t slots = 0;              //the beginning of the slots text
+   uint32_t capture = 0;          //the depth of the slots object being captured
+   uint32_t depth = 0;
+
+   Encoder()
+   {
+      data.resize(sizeof(LottieBinaryHeader));
+   }
+
+   void write(LottieToken token)
+   {
+      data.push_back(static_cast<char>(token));
+   }
+
+   template<typename T>
+   void write(LottieToken token, T val)
+   {
+      write(token);
+      auto p = reinterpret_cast<const char*>(&val);
+      data.insert(data.end(), p, p + sizeof(T));
+   }
+
+   void write(LottieToken token, const char* str, size_t length)
+   {
+      write(token, static_cast<uint32_t>(length));
+      data.insert(data.end(), str, str + length);
+      data.push_back('\0');
+   }
+
+   //returns false if the value belongs to the slots text
+   bool value(float val = 0.0f)
+   {
+      if (capture > 0) return false;
+      if (info) *info = val;
+      info = nullptr;
+      slots = 0;
+      return true;
+   }
+
+   bool Null() { if (value()) write(LottieToken::Null); return true; }
+   bool Bool(bool b) { if (value()) write(b ? LottieToken::True : LottieToken::False); return true; }
+   bool Int64(int64_t i) { return Double(static_cast<double>(i)); }
+   bool Uint64(uint64_t u) { return Double(static_cast<double>(u)); }
+   bool RawNumber(const char*, SizeType, bool) { return false; }
+
+   bool Int(int i)
+   {
+      if (value(static_cast<float>(i))) write(LottieToken::Int, static_cast<int32_t>(i));
+      return true;
+   }
+
+   bool Uint(unsigned u)
+   {
+      if (u > INT32_MAX) return Double(u);
+      return Int(static_cast<int>(u));
+   }
+
+   bool Double(double d)
+   {
+      if (value(static_cast<float>(d))) write(LottieToken::Float, static_cast<float>(d));
+      return true;
+   }
+
+   bool String(const char* str, SizeType length, bool)
+   {
+      if (value()) write(LottieToken::String, str, length);
+      return true;
+   }
+
+   bool Key(const char* str, SizeType length, bool)
+   {
+      if (capture > 0) return true;
+      write(LottieToken::Key, str, length);
+      if (depth != 1) return true;
+      if (!strcmp(str, "fr")) info = &header.frameRate;
+      else if (!strcmp(str, "ip")) info = &header.startFrame;
+      else if (!strcmp(str, "op")) info = &header.endFrame;
+      else if (!strcmp(str, "w")) info = &header.w;
+      else if (!strcmp(str, "h")) info = &header.h;
+      else if (!strcmp(str, "slots")) slots = ss->Tell();
+      return true;
+   }
+
+   bool StartObject()
+   {
+      ++depth;
+      //the slots are kept in the json text, the loader parses them on demand.
+      if (capture > 0 || slots > 0) ++capture;
+      else value();
+      if (capture == 0) write(LottieToken::StartObject);
+      return true;
+   }
+
+   bool EndObject(SizeType)
+   {
+      --depth;
+      if (capture == 0) write(LottieToken::EndObject);
+      else if (--capture == 0) {
+         auto begin = src + slots;
+         auto end = src + ss->Tell();
+         while (begin < end && *begin != '{') ++begin;   //skip the separator
+         write(LottieToken::String, begin, end - begin);
+         slots = 0;
+      }
+      return true;
+   }
+
+   bool StartArray()
+   {
+      if (value()) write(LottieToken::StartArray);
+      return true;
+   }
+
+   bool EndArray(SizeType)
+   {
+      if (capture == 0) write(LottieToken::EndArray);
+      return true;
+   }
+
+   bool encode(const char* json)
+   {
+      src = json;
+      StringStream stream(src);
+      ss = &stream;
+
+      Reader reader;
+      reader.IterativeParseInit();
+      while (!reader.IterativeParseComplete()) {
+         if (!reader.IterativeParseNext<kParseDefaultFlags>(stream, *this)) return false;
+      }
+      memcpy(data.data(), &header, sizeof(header));
+      return header.frameRate > 0.0f;
+   }
+};
+
+
+struct App
+{
+private:
+   char full[PATH_MAX];    //full path
+
+   void helpMsg()
+   {
+      cout << "Usage: \n   tvg-lottie2bin [Lottie file] or [Lottie folder]\n\nExamples: \n    $ tvg-lottie2bin input.json\n    $ tvg-lottie2bin lottiefolder\n\n";
+   }
+
+   bool validate(string& lottieName)
+   {
+      string extn = ".json";
+
+      if (lottieName.size() <= extn.size() || lottieName.substr(lottieName.size() - extn.size()) != extn) {
+         cout << "Error: \"" << lottieName << "\" is invalid." << endl;
+         return false;
+      }
+      return true;
+   }
+
+   //the pre-tokenized one must be loaded as same as the origin
+   bool verify(string& in, string& out)
+   {
+      if (Initializer::init() != Result::Success) return false;
+
+      auto ret = false;
+      {
+         auto origin = unique_ptr<Animation>(Animation::gen());
+         auto binary = unique_ptr<Animation>(Animation::gen());
+
+         if (origin->picture()->load(in.c_str()) == Result::Success && binary->picture()->load(out.c_str()) == Result::Success) {
+            float w1, h1, w2, h2;
+            origin->picture()->size(&w1, &h1);
+            binary->picture()->size(&w2, &h2);
+            ret = (w1 == w2 && h1 == h2 && origin->totalFrame() == binary->totalFrame());
+         }
+      }
+
+      if (Initializer::term() != Result::Success) return false;
+
+      return ret;
+   }
+
+   bool convert(string& in, string& out)
+   {
+      ifstream file(in, ios::binary);
+      if (!file) return false;
+
+      stringstream json;
+      json << file.rdbuf();
+
+      Encoder encoder;
+      if (!encoder.encode(json.str().c_str())) return false;
+
+      ofstream bin(out, ios::binary);
+      if (!bin.write(encoder.data.data(), encoder.data.size())) return false;
+      bin.close();
+
+      return verify(in, out);
+   }
+
+   void convert(string& lottieName)
+   {
+      //Get lotb file
+      auto binName = lottieName;
+      binName.replace(binName.length() - 4, 4, "lotb");
+
+      if (convert(lottieName, binName)) {
+         cout << "Generated Lotb file : " << binName << endl;
+      } else {
+         cout << "Failed Converting Lotb file : " << lottieName << endl;
+      }
+   }
+
+   const char* realPath(const char* path)
+   {
+#ifdef _WIN32
+      return _fullpath(full, path, PATH_MAX);
+#else
+      return realpath(path, full);
+#endif
+   }
+
+   bool isDirectory(const char* path)
+   {
+#ifdef _WIN32
+      DWORD attr = GetFileAttributes(path);
+      if (attr == INVALID_FILE_ATTRIBUTES) return false;
+      return attr & FILE_ATTRIBUTE_DIRECTORY;
+#else
+      struct stat buf;
+      if (stat(path, &buf) != 0) return false;
+      return S_ISDIR(buf.st_mode);
+#endif
+   }
+
+   bool handleDirectory(const string& path)
+   {
+#ifdef _WIN32
+        //open directory
+        WIN32_FIND_DATA fd;
+        HANDLE h = FindFirstFileEx((path + "\\*").c_str(), FindExInfoBasic, &fd, FindExSearchNameMatch, NULL, 0);
+        if (h == INVALID_HANDLE_VALUE) {
+            cout << "Couldn't open directory \"" << path.c_str() << "\"." << endl;
+            return false;
+        }
+        //List directories
+        do {
+            if (*fd.cFileName == '.' || *fd.cFileName == '$') continue;
+            //sub directory
+            if (fd.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) {
+                string subpath = string(path);
+                subpath += '\\';
+                subpath += fd.cFileName;
+                if (!handleDirectory(subpath)) continue;
+            //file
+            } else {
+                string lottieName(fd.cFileName);
+                if (!validate(lottieName)) continue;
+                lottieName = string(path);
+                lottieName += '\\';
+                lottieName += fd.cFileName;
+                convert(lottieName);
+            }
+        } while (FindNextFile(h, &fd));
+
+        FindClose(h);
+#else
+        //open directory
+        auto dir = opendir(path.c_str());
+        if (!dir) {
+            cout << "Couldn't open directory \"" << path.c_str() << "\"." << endl;
+            return false;
+        }
+        //List directories
+        while (auto entry = readdir(dir)) {
+            if (*entry->d_name == '.' || *entry->d_name == '$') continue;
+            //sub directory
+            if (entry->d_type == DT_DIR) {
+                string subpath = string(path);
+                subpath += '/';
+                subpath += entry->d_name;
+                if (!handleDirectory(subpath)) continue;
+            //file
+            } else {
+                string lottieName(entry->d_name);
+                if (!validate(lottieName)) continue;
+                lottieName = string(path);
+                lottieName += '/';
+                lottieName += entry->d_name;
+                convert(lottieName);
+            }
+        }
+#endif
+        return true;
+    }
+
+public:
+   int setup(int argc, char** argv)
+   {
+      //Collect input files
+      vector<const char*> inputs;
+
+      for (int i = 1; i < argc; ++i) {
+         if (*argv[i] == '-') cout << "Warning: Unknown flag (" << argv[i] << ")." << endl;
+         else inputs.push_back(argv[i]);
+      }
+
+      //No Input Lottie
+      if (inputs.empty()) {
+         helpMsg();
+         return 0;
+      }
+
+      for (auto input : inputs) {
+
+         auto path = realPath(input);
+         if (!path) {
+            cout << "Invalid file or path name: \"" << input << "\"" << endl;
+            continue;
+         }
+
+         if (isDirectory(path)) {
+            //load from directory
+            cout << "Directory: \"" << path << "\"" << endl;
+            if (!handleDirectory(path)) break;
+         }
+         else {
+            string lottieName(input);
+            if (!validate(lottieName)) continue;
+            convert(lottieName);
+         }
+      }
+      return 0;
+   }
+};
+
+
+int main(int argc, char **argv)
+{
+   App app;
+   return app.setup(argc, argv);
+}